@@ -0,0 +1,277 @@
+#include "StarletEngine/engine.hpp"
+#include "sceneGenerator.hpp"
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static std::atomic<std::size_t> allocationCount{ 0 };
+
+void* operator new(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size > 0 ? size : 1)) return memory;
+  throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+  struct BenchOptions {
+    std::size_t entities{ 10000 };
+    unsigned int steps{ 1000 };
+    unsigned int events{ 10000 };
+    unsigned int frames{ 100 };
+    std::size_t scalingMax{ 0 };
+    bool gpu{ false };
+    bool checkAllocations{ false };
+    const char* output{ nullptr };
+    const char* replay{ nullptr };
+  };
+
+  FILE* out{ stdout };
+
+  void report(const char* bench, const std::size_t entities, const std::size_t iterations, const double seconds) {
+    const double nsPerOp = iterations > 0 ? seconds * 1e9 / static_cast<double>(iterations) : 0.0;
+    std::fprintf(out, "{\"bench\":\"%s\",\"entities\":%zu,\"iterations\":%zu,\"seconds\":%.9f,\"nsPerOp\":%.3f}\n",
+      bench, entities, iterations, seconds, nsPerOp);
+  }
+
+  SceneSpec makeSpec(const std::size_t entities) {
+    SceneSpec spec;
+    spec.models = entities;
+    spec.velocities = entities;
+    spec.cameras = 4;
+    spec.grids = entities / 100;
+    return spec;
+  }
+
+  std::size_t peakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<std::size_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#endif
+#endif
+  }
+
+  bool parseArgs(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+      const bool hasValue = i + 1 < argc;
+      if (std::strcmp(argv[i], "--entities") == 0 && hasValue) options.entities = std::strtoull(argv[++i], nullptr, 10);
+      else if (std::strcmp(argv[i], "--steps") == 0 && hasValue) options.steps = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+      else if (std::strcmp(argv[i], "--events") == 0 && hasValue) options.events = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+      else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) options.frames = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+      else if (std::strcmp(argv[i], "--scaling") == 0) options.scalingMax = hasValue && argv[i + 1][0] != '-' ? std::strtoull(argv[++i], nullptr, 10) : 1000000;
+      else if (std::strcmp(argv[i], "--out") == 0 && hasValue) options.output = argv[++i];
+      else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) options.replay = argv[++i];
+      else if (std::strcmp(argv[i], "--gpu") == 0) options.gpu = true;
+      else if (std::strcmp(argv[i], "--check-allocations") == 0) options.checkAllocations = true;
+      else {
+        std::fprintf(stderr, "Usage: %s [--entities N] [--steps N] [--events N] [--frames N] [--scaling [maxEntities]] [--gpu] [--check-allocations] [--replay file] [--out file]\n", argv[0]);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void benchSystems(const BenchOptions& options) {
+    Engine engine;
+    if (!engine.initializeHeadless()) return;
+
+    const SceneSpec spec = makeSpec(options.entities);
+    if (!engine.loadGeneratedScene("BenchSystems", [&spec](Scene& scene) { generateScene(scene, spec); })) return;
+
+    for (const LoadStageTiming& timing : engine.getLoadTimings())
+      report(timing.name, options.entities, 1, timing.seconds);
+
+    const HeadlessStats stats = engine.runHeadless(options.steps, 1.0f / 60.0f);
+    report("runHeadless", options.entities, stats.steps, stats.seconds);
+  }
+
+  void benchInput(const BenchOptions& options) {
+    Engine engine;
+    if (!engine.initializeHeadless()) return;
+    if (!engine.loadGeneratedScene("BenchInput", [](Scene& scene) { generateScene(scene, SceneSpec{}); })) return;
+
+    using Clock = std::chrono::steady_clock;
+    const unsigned int perFrame = static_cast<unsigned int>(Engine::KeyEventQueue::capacity());
+
+    std::size_t dispatched = 0;
+    double seconds = 0.0;
+    for (unsigned int sent = 0; sent < options.events;) {
+      const unsigned int count = std::min(perFrame, options.events - sent);
+      for (unsigned int i = 0; i < count; ++i, ++sent) {
+        engine.onKey({ GLFW_KEY_A, (sent & 1) ? GLFW_RELEASE : GLFW_PRESS, 0 });
+        engine.onButton({ GLFW_MOUSE_BUTTON_LEFT, (sent & 1) ? GLFW_RELEASE : GLFW_PRESS, 0 });
+      }
+
+      const Clock::time_point start = Clock::now();
+      engine.dispatchInput();
+      seconds += std::chrono::duration<double>(Clock::now() - start).count();
+      dispatched += static_cast<std::size_t>(count) * 2;
+    }
+
+    report("inputDispatch", 0, dispatched, seconds);
+  }
+
+  void benchReplay(const BenchOptions& options) {
+    Engine engine;
+    if (!engine.initializeHeadless()) return;
+
+    const SceneSpec spec = makeSpec(options.entities);
+    if (!engine.loadGeneratedScene("BenchReplay", [&spec](Scene& scene) { generateScene(scene, spec); })) return;
+
+    const HeadlessStats stats = engine.replayHeadless(options.replay);
+    report("replayHeadless", options.entities, stats.steps, stats.seconds);
+  }
+
+  bool benchInputAllocations(const BenchOptions& options) {
+    Engine engine;
+    if (!engine.initializeHeadless()) return false;
+    if (!engine.loadGeneratedScene("BenchInputAllocations", [](Scene& scene) { generateScene(scene, SceneSpec{}); })) return false;
+
+    constexpr unsigned int warmupFrames = 64;
+    constexpr unsigned int cyclesPerFrame = 4;
+    constexpr unsigned int repeatsPerCycle = 4;
+    constexpr unsigned int eventsPerFrame = cyclesPerFrame * (repeatsPerCycle + 5);
+    const unsigned int frames = options.steps;
+
+    std::size_t allocations = 0;
+    for (unsigned int frame = 0; frame < warmupFrames + frames; ++frame) {
+      const std::size_t before = allocationCount.load(std::memory_order_relaxed);
+
+      for (unsigned int cycle = 0; cycle < cyclesPerFrame; ++cycle) {
+        engine.onKey({ GLFW_KEY_W, GLFW_PRESS, 0 });
+        for (unsigned int i = 0; i < repeatsPerCycle; ++i) engine.onKey({ GLFW_KEY_W, GLFW_REPEAT, 0 });
+        engine.onKey({ GLFW_KEY_W, GLFW_RELEASE, 0 });
+
+        engine.onButton({ GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, 0 });
+        engine.onButton({ GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE, 0 });
+        engine.onScroll(0.0, 1.0);
+      }
+      engine.dispatchInput();
+
+      if (frame >= warmupFrames) allocations += allocationCount.load(std::memory_order_relaxed) - before;
+    }
+
+    std::fprintf(out, "{\"bench\":\"inputAllocations\",\"frames\":%u,\"eventsPerFrame\":%u,\"allocations\":%zu}\n",
+      frames, eventsPerFrame, allocations);
+    return allocations == 0;
+  }
+
+  void benchScaling(const BenchOptions& options) {
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "starletBenchScaling";
+    std::error_code errorCode;
+    std::filesystem::remove_all(root, errorCode);
+    if (!std::filesystem::create_directories(root / "scenes", errorCode)) {
+      std::fprintf(stderr, "Failed to create %s\n", root.string().c_str());
+      return;
+    }
+
+    for (std::size_t entities = 1000; entities <= options.scalingMax; entities *= 10) {
+      Engine engine;
+      const bool ready = options.gpu ? engine.initialize(1, 1, "StarletEngineBench") : engine.initializeHeadless();
+      if (!ready) {
+        std::fprintf(stderr, "Failed to initialize engine for scaling run at %zu entities\n", entities);
+        break;
+      }
+
+      const SceneSpec spec = stressSpec(entities);
+      const std::string sceneName = "BenchScaling" + std::to_string(entities);
+      if (!writeSceneText((root / "scenes" / (sceneName + ".txt")).string(), spec)) {
+        std::fprintf(stderr, "Failed to write scaling scene %s\n", sceneName.c_str());
+        break;
+      }
+      engine.setAssetPaths(root.string());
+
+      using Clock = std::chrono::steady_clock;
+      const Clock::time_point loadStart = Clock::now();
+      if (!engine.loadScene(sceneName)) break;
+      const double loadSeconds = std::chrono::duration<double>(Clock::now() - loadStart).count();
+
+      double parseSeconds = 0.0, stageSeconds = 0.0;
+      for (const LoadStageTiming& timing : engine.getLoadTimings())
+        (std::strcmp(timing.name, "parseScene") == 0 ? parseSeconds : stageSeconds) += timing.seconds;
+
+      const HeadlessStats stats = engine.runHeadless(options.frames, 1.0f / 60.0f);
+      const double frameMs = stats.steps > 0 ? stats.seconds * 1000.0 / static_cast<double>(stats.steps) : 0.0;
+
+      std::fprintf(out, "{\"bench\":\"scaling\",\"entities\":%zu,\"models\":%zu,\"lights\":%zu,\"cameras\":%zu,\"velocities\":%zu,\"grids\":%zu,"
+        "\"loadSeconds\":%.9f,\"parseSeconds\":%.9f,\"stageSeconds\":%.9f,\"frames\":%u,\"frameMs\":%.6f,\"peakRssKb\":%zu}\n",
+        spec.entityCount(), spec.models, spec.lights, spec.cameras, spec.velocities, spec.grids,
+        loadSeconds, parseSeconds, stageSeconds, stats.steps, frameMs, peakRssKb());
+      std::fflush(out);
+    }
+
+    std::filesystem::remove_all(root, errorCode);
+  }
+
+  void benchLoadStages(const BenchOptions& options) {
+    Engine engine;
+    if (!engine.initialize(1, 1, "StarletEngineBench")) {
+      std::fprintf(stderr, "No GL context available, skipping load stage benchmarks\n");
+      return;
+    }
+
+    const SceneSpec spec = makeSpec(options.entities);
+    if (!engine.loadGeneratedScene("BenchLoad", [&spec](Scene& scene) { generateScene(scene, spec); })) return;
+
+    for (const LoadStageTiming& timing : engine.getLoadTimings())
+      report(timing.name, options.entities, 1, timing.seconds);
+  }
+}
+
+int main(int argc, char** argv) {
+  BenchOptions options;
+  if (!parseArgs(argc, argv, options)) return EXIT_FAILURE;
+
+  if (options.output) {
+    out = std::fopen(options.output, "w");
+    if (!out) {
+      std::fprintf(stderr, "Failed to open %s\n", options.output);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (options.scalingMax > 0) {
+    benchScaling(options);
+    if (out != stdout) std::fclose(out);
+    return EXIT_SUCCESS;
+  }
+
+  benchSystems(options);
+  benchInput(options);
+  const bool inputAllocationFree = benchInputAllocations(options);
+  if (options.replay) benchReplay(options);
+  if (options.gpu) benchLoadStages(options);
+
+  if (out != stdout) std::fclose(out);
+
+  if (options.checkAllocations && !inputAllocationFree) {
+    std::fprintf(stderr, "Input path allocated in steady state (build with NDEBUG to strip input logging)\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include "sceneGenerator.hpp"
+
+#include "StarletScene/scene.hpp"
+#include "StarletScene/components/model.hpp"
+#include "StarletScene/components/camera.hpp"
+#include "StarletScene/components/light.hpp"
+#include "StarletScene/components/transform.hpp"
+#include "StarletScene/components/velocity.hpp"
+#include "StarletScene/components/grid.hpp"
+
+#include <fstream>
+
+SceneSpec stressSpec(const std::size_t entities) {
+  SceneSpec spec;
+  spec.cameras = 4;
+  spec.lights = entities / 1000 > 0 ? entities / 1000 : 1;
+  spec.grids = entities / 1000;
+
+  const std::size_t fixed = spec.cameras + spec.lights + spec.grids;
+  const std::size_t dynamic = entities > fixed ? entities - fixed : 0;
+  spec.models = dynamic / 2;
+  spec.velocities = dynamic;
+  return spec;
+}
+
+void generateScene(Scene& scene, const SceneSpec& spec) {
+  for (std::size_t i = 0; i < spec.cameras; ++i) {
+    const Entity entity = scene.createEntity();
+    scene.addComponent<Camera>(entity);
+    scene.addComponent<Transform>(entity);
+  }
+
+  for (std::size_t i = 0; i < spec.models; ++i) {
+    const Entity entity = scene.createEntity();
+    scene.addComponent<Model>(entity);
+    scene.addComponent<Transform>(entity);
+    if (i < spec.velocities) scene.addComponent<Velocity>(entity);
+  }
+
+  for (std::size_t i = spec.models; i < spec.velocities; ++i) {
+    const Entity entity = scene.createEntity();
+    scene.addComponent<Transform>(entity);
+    scene.addComponent<Velocity>(entity);
+  }
+
+  for (std::size_t i = 0; i < spec.lights; ++i) {
+    const Entity entity = scene.createEntity();
+    scene.addComponent<Light>(entity);
+    scene.addComponent<Transform>(entity);
+  }
+
+  for (std::size_t i = 0; i < spec.grids; ++i) {
+    const Entity entity = scene.createEntity();
+    scene.addComponent<Grid>(entity);
+    scene.addComponent<Transform>(entity);
+  }
+}
+
+bool writeSceneText(const std::string& path, const SceneSpec& spec) {
+  std::ofstream file(path);
+  if (!file) return false;
+
+  const auto position = [&file](const std::size_t i) {
+    file << "  position " << static_cast<float>(i % 100) << " 0 " << static_cast<float>(i / 100) << "\n";
+  };
+
+  for (std::size_t i = 0; i < spec.cameras; ++i) {
+    file << "camera Camera" << i << "\n";
+    position(i);
+  }
+
+  for (std::size_t i = 0; i < spec.models; ++i) {
+    file << "model Model" << i << "\n";
+    position(i);
+    if (i < spec.velocities) file << "  velocity 1 0 0\n";
+  }
+
+  for (std::size_t i = spec.models; i < spec.velocities; ++i) {
+    file << "object Object" << i << "\n";
+    position(i);
+    file << "  velocity 1 0 0\n";
+  }
+
+  for (std::size_t i = 0; i < spec.lights; ++i) {
+    file << "light Light" << i << "\n";
+    position(i);
+  }
+
+  for (std::size_t i = 0; i < spec.grids; ++i) {
+    file << "grid Grid" << i << "\n";
+    position(i);
+  }
+
+  return static_cast<bool>(file);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class Scene;
+
+struct SceneSpec {
+	std::size_t models{ 0 };
+	std::size_t velocities{ 0 };
+	std::size_t lights{ 0 };
+	std::size_t cameras{ 1 };
+	std::size_t grids{ 0 };
+
+	std::size_t entityCount() const { return (models > velocities ? models : velocities) + lights + cameras + grids; }
+};
+
+SceneSpec stressSpec(const std::size_t entities);
+void generateScene(Scene& scene, const SceneSpec& spec);
+bool writeSceneText(const std::string& path, const SceneSpec& spec);
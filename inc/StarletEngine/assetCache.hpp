@@ -0,0 +1,84 @@
+#pragma once
+
+#include "StarletEngine/mappedFile.hpp"
+#include "StarletEngine/resourceResidency.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Scene;
+
+// name is what the renderer looks the resource up by (Model::meshPath, TextureData::name); sourcePath is the file it decodes from.
+struct AssetRequest {
+	ResourceClass type{ ResourceClass::Mesh };
+	std::string name;
+	std::string sourcePath;
+	std::string importSettings;
+};
+
+// decode produces the ready-to-upload payload (vertex/index buffers, texels and any mips);
+// upload receives either a fresh decode or the mapped cache entry.
+struct AssetCacheHooks {
+	std::function<void(Scene&, ResourceClass, std::vector<AssetRequest>&)> collect;
+	std::function<bool(const AssetRequest&, std::vector<unsigned char>&)> decode;
+	std::function<bool(const AssetRequest&, const unsigned char*, const std::size_t)> upload;
+};
+
+struct AssetCacheStats {
+	std::size_t hits{ 0 };
+	std::size_t misses{ 0 };
+	std::size_t bytesRead{ 0 };
+	std::size_t bytesWritten{ 0 };
+};
+
+// A ready-to-upload payload, pointing into either the mapped cache entry or a fresh decode.
+struct PreparedAsset {
+	AssetRequest request;
+	MappedFile cached;
+	std::vector<unsigned char> decoded;
+	const unsigned char* data{ nullptr };
+	std::size_t size{ 0 };
+};
+
+class AssetCache {
+public:
+	static constexpr std::uint32_t Version{ 1 };
+
+	void setDirectory(const std::string& path) { directory = path; }
+	const std::string& getDirectory() const { return directory; }
+	bool isEnabled() const { return !directory.empty(); }
+
+	bool load(const AssetRequest& request, const AssetCacheHooks& hooks);
+	// Safe to call from several threads at once; only the upload has to happen on the thread owning the GPU.
+	bool prepare(const AssetRequest& request, const AssetCacheHooks& hooks, PreparedAsset& prepared);
+
+	static bool computeKey(const AssetRequest& request, std::uint64_t& key);
+	std::string entryPath(const std::uint64_t key) const;
+
+	AssetCacheStats getStats() const;
+	void resetStats();
+
+private:
+	struct Header {
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t type;
+		std::uint32_t reserved;
+		std::uint64_t key;
+		std::uint64_t payloadSize;
+	};
+
+	std::string directory;
+	std::atomic<std::size_t> hits{ 0 };
+	std::atomic<std::size_t> misses{ 0 };
+	std::atomic<std::size_t> bytesRead{ 0 };
+	std::atomic<std::size_t> bytesWritten{ 0 };
+	std::atomic<unsigned int> nextTemporary{ 0 };
+
+	bool fetch(const std::uint64_t key, const ResourceClass type, MappedFile& file) const;
+	bool store(const std::uint64_t key, const ResourceClass type, const std::vector<unsigned char>& payload);
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "StarletEngine/assetCache.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Built-in decoders producing AssetStore payloads: ASCII PLY and OBJ meshes, uncompressed/RLE TGA and uncompressed BMP textures.
+class AssetDecoder {
+public:
+	static bool canDecode(const ResourceClass type, const std::string& path);
+	static bool decode(const AssetRequest& request, std::vector<unsigned char>& payload);
+
+	static bool decodeObj(const std::string& path, std::vector<unsigned char>& payload);
+	static bool decodePly(const std::string& path, std::vector<unsigned char>& payload);
+	static bool decodeTga(const std::string& path, std::vector<unsigned char>& payload);
+	static bool decodeBmp(const std::string& path, std::vector<unsigned char>& payload);
+
+private:
+	static void writeMesh(const std::vector<float>& vertices, const std::vector<std::uint32_t>& indices, std::vector<unsigned char>& payload);
+	static void writeTexture(const unsigned int width, const unsigned int height, std::vector<unsigned char>& texels, std::vector<unsigned char>& payload);
+	static void computeNormals(std::vector<float>& vertices, const std::vector<std::uint32_t>& indices);
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "StarletEngine/assetCache.hpp"
+#include "StarletEngine/resourceResidency.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+// Mesh payload: header, vertexCount * (position xyz, normal xyz, uv) floats, then indexCount uint32 indices.
+struct MeshPayloadHeader {
+	std::uint32_t vertexCount;
+	std::uint32_t indexCount;
+};
+
+// Texture payload: header, then RGBA8 texels for each mip level, each level half the size of the previous one.
+struct TexturePayloadHeader {
+	std::uint32_t width;
+	std::uint32_t height;
+	std::uint32_t levels;
+};
+
+struct GpuAsset {
+	unsigned int handles[3]{ 0, 0, 0 };
+	unsigned int count{ 0 };
+	std::size_t gpuBytes{ 0 };
+};
+
+// upload hands a validated payload to whatever owns the GPU copy; release frees it again by resource name.
+struct AssetBackend {
+	std::function<bool(const AssetRequest&, const unsigned char*, const std::size_t, GpuAsset&)> upload;
+	std::function<void(ResourceClass, const std::string&, const GpuAsset&)> release;
+};
+
+class AssetStore {
+public:
+	static constexpr std::size_t MeshVertexFloats{ 8 };
+
+	AssetStore() = default;
+	~AssetStore() { releaseAll(); }
+
+	AssetStore(const AssetStore&) = delete;
+	AssetStore& operator=(const AssetStore&) = delete;
+
+	void setBackend(AssetBackend backendIn) { releaseAll(); backend = std::move(backendIn); }
+
+	bool upload(const AssetRequest& request, const unsigned char* data, const std::size_t size);
+	bool release(const ResourceUsage& usage);
+	void releaseAll();
+
+	bool getUsage(const AssetRequest& request, ResourceUsage& usage) const;
+	const GpuAsset* find(const ResourceClass type, const std::string& name) const;
+
+	std::size_t getCount() const { return assets.size(); }
+	std::size_t getReleased() const { return released; }
+	std::size_t getUploads() const { return uploads; }
+
+	static bool validate(const ResourceClass type, const unsigned char* data, const std::size_t size);
+
+private:
+	struct Entry {
+		ResourceClass type;
+		std::string name;
+		GpuAsset asset;
+	};
+
+	AssetBackend backend;
+	std::unordered_map<std::string, Entry> assets;
+	std::size_t released{ 0 };
+	std::size_t uploads{ 0 };
+
+	static std::string key(const ResourceClass type, const std::string& name);
+};
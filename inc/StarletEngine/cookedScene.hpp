@@ -0,0 +1,47 @@
+#pragma once
+
+#include "StarletEngine/mappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Scene;
+
+// restore may keep pointers into the payload; the mapping stays open until the scene is replaced or unloaded.
+// layout identifies the component layouts the payload was cooked with; files cooked with another layout are ignored.
+struct SceneCookHooks {
+	std::function<bool(Scene&, std::vector<unsigned char>&)> cook;
+	std::function<bool(Scene&, const unsigned char*, const std::size_t)> restore;
+	std::uint64_t layout{ 0 };
+};
+
+class CookedScene {
+public:
+	static constexpr std::uint32_t Version{ 2 };
+
+	static bool write(const std::string& cookedPath, const std::string& sourcePath, const std::uint64_t layout, const std::vector<unsigned char>& payload);
+
+	bool open(const std::string& cookedPath, const std::string& sourcePath, const std::uint64_t layout);
+
+	const unsigned char* getPayload() const { return payload; }
+	std::size_t getPayloadSize() const { return payloadSize; }
+
+private:
+	struct Header {
+		char magic[4];
+		std::uint32_t version;
+		std::uint64_t layout;
+		std::uint64_t sourceSize;
+		std::int64_t sourceTime;
+		std::uint64_t payloadSize;
+	};
+
+	MappedFile file;
+	const unsigned char* payload{ nullptr };
+	std::size_t payloadSize{ 0 };
+
+	static bool fingerprint(const std::string& sourcePath, std::uint64_t& size, std::int64_t& time);
+};
@@ -2,48 +2,268 @@
 
 #include "StarletEngine/windowManager.hpp"
 #include "StarletEngine/timer.hpp"
+#include "StarletEngine/fixedTimestep.hpp"
+#include "StarletEngine/threadPool.hpp"
+#include "StarletEngine/systemScheduler.hpp"
+#include "StarletEngine/uploadQueue.hpp"
+#include "StarletEngine/sceneLoadHandle.hpp"
+#include "StarletEngine/frameStats.hpp"
+#include "StarletEngine/profiler.hpp"
+#include "StarletEngine/metricsExporter.hpp"
+#include "StarletEngine/ringBuffer.hpp"
+#include "StarletEngine/inputRecording.hpp"
+#include "StarletEngine/cookedScene.hpp"
+#include "StarletEngine/viewport.hpp"
+#include "StarletEngine/fileWatcher.hpp"
+#include "StarletEngine/resourceResidency.hpp"
+#include "StarletEngine/assetCache.hpp"
+#include "StarletEngine/assetStore.hpp"
 #include "StarletControls/inputManager.hpp"
 
 #include "StarletScene/sceneManager.hpp"
+#include "StarletScene/components/camera.hpp"
+#include "StarletScene/components/light.hpp"
+#include "StarletScene/components/transform.hpp"
 
 #include "StarletGraphics/loader/resourceLoader.hpp"
 #include "StarletGraphics/manager/glStateManager.hpp"
 #include "StarletGraphics/manager/resourceManager.hpp"
 #include "StarletGraphics/renderer/renderer.hpp"
 
+#include <bitset>
+#include <functional>
+#include <memory>
+
+struct HeadlessStats {
+	unsigned int steps{ 0 };
+	double seconds{ 0.0 };
+	double stepsPerSecond{ 0.0 };
+};
+
+struct LoadStageTiming {
+	const char* name{ nullptr };
+	double seconds{ 0.0 };
+	std::size_t cacheHits{ 0 };
+	std::size_t cacheMisses{ 0 };
+};
+
 class Engine {
 public:
 	Engine();
-	~Engine() = default;
+	~Engine();
 
 	void setAssetPaths(const std::string& path);
+	bool enableHotReload();
 	bool initialize(const unsigned int width, const unsigned int height, const char* title);
+	bool initializeHeadless();
 
 	bool loadScene(const std::string& sceneIn = "Default");
+	SceneLoadHandle loadSceneAsync(const std::string& sceneIn = "Default");
+	bool loadGeneratedScene(const std::string& name, const std::function<void(Scene&)>& generate);
+	bool unloadScene();
+	const std::vector<LoadStageTiming>& getLoadTimings() const { return loadTimings; }
+
+	void setResourceResidencyHooks(ResourceResidencyHooks hooks) { residency.setHooks(std::move(hooks)); }
+	void setResourceBudget(const std::size_t cpuBytes, const std::size_t gpuBytes) { residency.setBudget(cpuBytes, gpuBytes); }
+	const ResourceResidency& getResourceResidency() const { return residency; }
+	const AssetStore& getAssetStore() const { return assetStore; }
+	void setAssetBackend(AssetBackend backend) { assetStore.setBackend(std::move(backend)); }
+
+	void setAssetCacheHooks(AssetCacheHooks hooks) { assetCacheHooks = std::move(hooks); }
+	void setAssetStoreEnabled(const bool enabled) { assetStoreEnabled = enabled; }
+	void setAssetCacheDirectory(const std::string& path) { assetCache.setDirectory(path); }
+	AssetCacheStats getAssetCacheStats() const { return assetCache.getStats(); }
+
+	void setSceneCookHooks(SceneCookHooks hooks) { sceneCookHooks = std::move(hooks); }
+	bool cookScene(const std::string& sceneIn);
+	void setUploadsPerFrame(const std::size_t count) { uploadsPerFrame = count > 0 ? count : 1; }
 	void run();
+	HeadlessStats runHeadless(const unsigned int steps, const float fixedDt);
+	HeadlessStats replayHeadless(const std::string& path);
+
+	bool startInputRecording(const std::string& path) { return inputRecorder.open(path); }
+	void stopInputRecording() { inputRecorder.close(); }
+	bool startInputReplay(const std::string& path) { return inputReplay.open(path); }
+	bool isReplayingInput() const { return inputReplay.isActive(); }
 
-	void updateViewport(const int width, const int height) { windowManager.updateViewport(width, height); }
+	void  setFixedUpdateRate(const double hz, const unsigned int maxCatchUpSteps) { fixedTimestep.setRate(hz, maxCatchUpSteps); }
+	float getInterpolationAlpha() const { return fixedTimestep.getAlpha(); }
+	void  setPipelinedFrames(const bool enabled) { pipelinedFrames = enabled; }
 
-	void onKey(const KeyEvent& event) { inputManager.onKey(event); }
-	void onScroll(double xOffset, double yOffset) { inputManager.onScroll(xOffset, yOffset); }
-	void onButton(const MouseButtonEvent& event) { inputManager.onButton(event); }
+	void setGLVersion(const int major, const int minor) { windowManager.setContextVersion(major, minor); }
+	bool setFramePacing(const PacingMode mode, const double targetFps = 0.0);
+	const FrameStats& getFrameJitter() const { return framePacer.getJitter(); }
+
+	SystemScheduler& getSystemScheduler() { return systemScheduler; }
+	ThreadPool& getThreadPool() { return threadPool; }
+
+	const FrameStats& getFrameStats() const { return frameStats; }
+	bool writeProfileTrace(const std::string& path) { return Profiler::instance().writeChromeTrace(path); }
+
+	bool startMetricsFile(const std::string& path, const double intervalSeconds = 1.0) { return metricsExporter.startFile(path, intervalSeconds); }
+	bool startMetricsSocket(const std::string& path, const double intervalSeconds = 1.0) { return metricsExporter.startSocket(path, intervalSeconds); }
+	void stopMetrics() { metricsExporter.stop(); }
+
+	void updateViewport(GLFWwindow* window, const int width, const int height) { windowManager.updateViewport(window, width, height); }
+
+	bool addViewport(const unsigned int width, const unsigned int height, const char* title, Viewport::CameraSelector selectCamera);
+	void setMainCamera(Viewport::CameraSelector selectCamera) { mainCameraSelector = std::move(selectCamera); }
+
+	using KeyEventQueue = RingBuffer<KeyEvent, 256>;
+	using ButtonEventQueue = RingBuffer<MouseButtonEvent, 256>;
+
+	void onKey(const KeyEvent& event) { if (!inputReplay.isActive()) queueKey(event); }
+	void onScroll(double xOffset, double yOffset) { if (!inputReplay.isActive()) queueScroll(xOffset, yOffset); }
+	void onButton(const MouseButtonEvent& event) { if (!inputReplay.isActive()) queueButton(event); }
+	void dispatchInput();
 
 	void toggleCursorLock() { inputManager.setCursorLocked(windowManager.switchCursorLock()); }
 	void toggleWireframe() { glState.toggleWireframe(); };
 
 private:
+	struct LoadStage {
+		const char* name;
+		const char* description;
+		std::function<bool(SceneManager&, const std::string&)> run;
+		bool cpuSide{ false };
+		ResourceClass assets{ ResourceClass::Count };
+	};
+
+	// Copied on the calling thread so async loads never read engine settings from the worker.
+	struct LoadSettings {
+		std::string scenePath;
+		std::string assetPath;
+		SceneCookHooks sceneCookHooks;
+		AssetCacheHooks assetCacheHooks;
+		bool assetStoreEnabled{ false };
+	};
+
+	struct SimulationBinding {
+		Entity simulation;
+		Entity render;
+	};
+
+	struct TransformState {
+		Entity simulation;
+		Entity render;
+		Transform previous;
+		Transform current;
+	};
+
+	struct RenderPacket {
+		std::vector<TransformState> transforms;
+		std::vector<std::pair<Entity, Camera>> cameras;
+		std::vector<std::pair<Entity, Light>> lights;
+	};
+
+	bool headless{ false };
+	bool pipelinedFrames{ false };
+	std::string assetPath;
+	std::string shaderPath;
+	std::string scenePath;
+	std::string currentScene;
+
+	FileWatcher fileWatcher;
+	std::vector<std::string> changedPaths;
+	double nextReloadPoll{ 0.0 };
+
+	UploadQueue uploadQueue;
+	std::size_t uploadsPerFrame{ 1 };
+	std::vector<LoadStageTiming> loadTimings;
+	SceneCookHooks sceneCookHooks;
+	AssetCacheHooks assetCacheHooks;
+	bool assetStoreEnabled{ false };
+	AssetCache assetCache;
+
+	ThreadPool threadPool;
+	SystemScheduler systemScheduler;
 
 	WindowManager windowManager;
 	Timer timer;
+	FixedTimestep fixedTimestep;
+	FrameStats frameStats;
+	FramePacer framePacer;
+	MetricsExporter metricsExporter;
 	InputManager inputManager;
+	KeyEventQueue keyEvents;
+	ButtonEventQueue buttonEvents;
+	double frameScrollX{ 0.0 }, frameScrollY{ 0.0 };
+	std::size_t reportedDrops{ 0 };
+	std::bitset<512> keysDown;
+	std::bitset<8> buttonsDown;
+	bool forwardedEvents{ false };
+
+	InputRecorder inputRecorder;
+	InputReplay inputReplay;
 	GLStateManager glState;
 
-	SceneManager sceneManager;
+	std::shared_ptr<SceneManager> sceneManager;
+	std::shared_ptr<SceneManager> simulationScene;
+	std::vector<SimulationBinding> simulationBindings;
+	RenderPacket renderPacket;
+	std::shared_ptr<const CookedScene> cookedScene;
+	std::vector<ResourceUsage> sceneResources;
+	ResourceResidency residency;
+	AssetStore assetStore;
 	ResourceManager resourceManager;
 	ResourceLoader resourceLoader;
 
 	Renderer renderer;
 
-	void handleKeyEvents(const std::vector<KeyEvent>& keyEvents);
-	void handleButtonEvents(const std::vector<MouseButtonEvent>& buttonEvents);
+	std::vector<std::unique_ptr<Viewport>> viewports;
+	Viewport::CameraSelector mainCameraSelector;
+	std::vector<Camera> savedCameras;
+
+	ThreadPool assetPool;
+	ThreadPool loadPool{ 1 };
+
+	LoadSettings getLoadSettings() const;
+	std::shared_ptr<SceneManager> parseScene(const std::string& sceneIn, const LoadSettings& settings, std::shared_ptr<const CookedScene>& cooked);
+	bool parseTextScene(SceneManager& target, const std::string& sceneIn);
+	std::shared_ptr<const CookedScene> restoreCookedScene(SceneManager& target, const std::string& sceneName, const LoadSettings& settings);
+	std::vector<LoadStage> getLoadStages();
+	bool loadAssets(SceneManager& target, const ResourceClass type);
+	static void collectSceneAssets(Scene& scene, const ResourceClass type, const std::string& root, std::vector<AssetRequest>& requests);
+	static void addAssetRequest(const ResourceClass type, const std::string& name, const std::string& file, const std::string& root, std::vector<AssetRequest>& requests);
+	std::vector<std::shared_ptr<PreparedAsset>> prepareAssets(Scene& scene, const ResourceClass type, const LoadSettings& settings);
+	AssetBackend rendererAssetBackend();
+	ResourceResidencyHooks engineResidencyHooks();
+	ResourceUsage rendererUsage(const ResourceClass type, const std::string& name) const;
+	void discardSceneAssets(SceneManager& target);
+	bool runLoadStage(const LoadStage& stage, SceneManager& target, const std::string& sceneIn);
+	void logLoadTimings(const std::string& sceneIn) const;
+
+	std::shared_ptr<SceneManager> createSceneManager() const { return createSceneManager(scenePath); }
+	static std::shared_ptr<SceneManager> createSceneManager(const std::string& basePath);
+	void activateScene(std::shared_ptr<SceneManager> next, const std::string& sceneName, std::shared_ptr<const CookedScene> cooked = nullptr);
+	void createSimulationScene();
+	void captureTransforms();
+	void fillRenderPacket();
+	void syncRenderScene();
+	void refreshSceneResources();
+	void updateResourceMetrics() const;
+
+	void processFileChanges();
+	void reloadAssets(const std::vector<std::string>& changedFiles);
+	bool reloadStoreAsset(const AssetRequest& request);
+	bool reloadShaders();
+
+	void registerSystems();
+	void renderViews();
+	void updateSystems(const float deltaTime);
+	void simulate(const unsigned int steps);
+	void updateSceneSystems(const unsigned int steps);
+	void presentFrame();
+	void logFramePacing() const;
+	void runPipelinedFrame(const unsigned int steps);
+
+	void queueKey(const KeyEvent& event);
+	void queueScroll(const double xOffset, const double yOffset) { inputManager.onScroll(xOffset, yOffset); frameScrollX += xOffset; frameScrollY += yOffset; }
+	void queueButton(const MouseButtonEvent& event);
+
+	bool replayFrame(double& frameDelta);
+	void recordFrame(const double frameDelta);
+
+	void handleKeyEvents(const KeyEventQueue::View& events);
+	void handleButtonEvents(const ButtonEventQueue::View& events);
 };
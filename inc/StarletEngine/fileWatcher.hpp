@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef __linux__
+#include <filesystem>
+#endif
+
+class FileWatcher {
+public:
+	FileWatcher() = default;
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	bool watch(const std::string& directory, const bool recursive);
+	void poll(std::vector<std::string>& changedPaths);
+	void close();
+
+	bool isActive() const;
+
+private:
+#ifdef __linux__
+	struct WatchedDirectory {
+		std::string path;
+		bool recursive;
+	};
+
+	int inotifyFd{ -1 };
+	std::unordered_map<int, WatchedDirectory> directories;
+
+	bool addWatch(const std::string& directory, const bool recursive);
+	void addCreatedDirectory(const std::string& directory, std::vector<std::string>& changedPaths);
+	static void report(std::string path, std::vector<std::string>& changedPaths);
+#else
+	std::vector<std::pair<std::string, bool>> roots;
+	std::unordered_map<std::string, std::filesystem::file_time_type> writeTimes;
+
+	void scan(std::vector<std::string>* changedPaths);
+#endif
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+class FixedTimestep {
+public:
+	void setRate(const double hz, const unsigned int maxStepsIn);
+
+	unsigned int advance(const double frameDelta);
+
+	float  getStepDelta()     const { return static_cast<float>(stepDelta); }
+	float  getAlpha()         const { return static_cast<float>(accumulator / stepDelta); }
+	double getDroppedTime()   const { return droppedTime; }
+	unsigned long long getClampedFrames() const { return clampedFrames; }
+
+private:
+	double stepDelta{ 1.0 / 60.0 };
+	double accumulator{ 0.0 };
+	unsigned int maxSteps{ 5 };
+
+	double droppedTime{ 0.0 };
+	unsigned long long clampedFrames{ 0 };
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "StarletEngine/frameStats.hpp"
+
+#include <chrono>
+
+enum class PacingMode {
+	Uncapped,
+	Vsync,
+	AdaptiveVsync,
+	TargetFps
+};
+
+const char* pacingModeName(const PacingMode mode);
+
+class FramePacer {
+public:
+	bool setMode(const PacingMode modeIn, const double targetFps = 0.0);
+	void setSpinThreshold(const double seconds) { spinThreshold = seconds > 0.0 ? seconds : 0.0; }
+
+	PacingMode getMode() const { return mode; }
+	double getTargetFps() const { return targetFps; }
+
+	void wait();
+	void recordFrame(const double frameSeconds);
+
+	const FrameStats& getJitter() const { return jitter; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	PacingMode mode{ PacingMode::Vsync };
+	double targetFps{ 0.0 };
+	Clock::duration framePeriod{ Clock::duration::zero() };
+	Clock::time_point deadline{};
+	double spinThreshold{ 0.002 };
+
+	FrameStats jitter;
+	double lastFrame{ 0.0 };
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+class FrameStats {
+public:
+	static constexpr std::size_t WindowSize{ 512 };
+
+	void addFrame(const double seconds);
+
+	std::size_t getCount() const { return count; }
+	double getLast() const { return count > 0 ? samples[(next + WindowSize - 1) % WindowSize] : 0.0; }
+	double getPercentile(const double percentile) const;
+	double getP50() const { return getPercentile(0.50); }
+	double getP99() const { return getPercentile(0.99); }
+
+private:
+	std::array<double, WindowSize> samples{};
+	std::size_t next{ 0 };
+	std::size_t count{ 0 };
+};
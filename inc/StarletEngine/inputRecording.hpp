@@ -0,0 +1,63 @@
+#pragma once
+
+#include "StarletControls/inputManager.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct InputFrame {
+	double deltaTime{ 0.0 };
+	double cursorX{ 0.0 }, cursorY{ 0.0 };
+	double scrollX{ 0.0 }, scrollY{ 0.0 };
+
+	std::uint32_t firstKey{ 0 }, keyCount{ 0 };
+	std::uint32_t firstButton{ 0 }, buttonCount{ 0 };
+};
+
+class InputRecorder {
+public:
+	bool open(const std::string& path);
+	void close();
+	bool isActive() const { return file.is_open(); }
+
+	template<typename KeyView, typename ButtonView>
+	void writeFrame(const InputFrame& frame, const KeyView& keys, const ButtonView& buttons) {
+		if (!file.is_open()) return;
+
+		writeHeader(frame, static_cast<std::uint16_t>(keys.size()), static_cast<std::uint16_t>(buttons.size()));
+		for (const KeyEvent& event : keys) writeKey(event);
+		for (const MouseButtonEvent& event : buttons) writeButton(event);
+		++frameCount;
+	}
+
+private:
+	std::ofstream file;
+	std::string path;
+	std::uint64_t frameCount{ 0 };
+
+	void writeHeader(const InputFrame& frame, const std::uint16_t keyCount, const std::uint16_t buttonCount);
+	void writeKey(const KeyEvent& event);
+	void writeButton(const MouseButtonEvent& event);
+};
+
+class InputReplay {
+public:
+	bool open(const std::string& path);
+	void close();
+	bool isActive() const { return active; }
+
+	const InputFrame* next();
+	const KeyEvent& getKey(const std::uint32_t index) const { return keys[index]; }
+	const MouseButtonEvent& getButton(const std::uint32_t index) const { return buttons[index]; }
+
+	std::size_t getFrameCount() const { return frames.size(); }
+
+private:
+	std::vector<InputFrame> frames;
+	std::vector<KeyEvent> keys;
+	std::vector<MouseButtonEvent> buttons;
+	std::size_t cursor{ 0 };
+	bool active{ false };
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Counter {
+public:
+	void add(const std::uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+	std::uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<std::uint64_t> value{ 0 };
+};
+
+class Gauge {
+public:
+	void set(const double valueIn) { value.store(valueIn, std::memory_order_relaxed); }
+	double get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<double> value{ 0.0 };
+};
+
+class Histogram {
+public:
+	explicit Histogram(std::vector<double> boundsIn);
+
+	void observe(const double sample);
+
+	const std::vector<double>& getBounds() const { return bounds; }
+	std::size_t getBucketCount() const { return bounds.size() + 1; }
+	std::uint64_t getBucket(const std::size_t index) const { return buckets[index].load(std::memory_order_relaxed); }
+	std::uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+	double getSum() const { return sum.load(std::memory_order_relaxed); }
+
+private:
+	const std::vector<double> bounds;
+	std::unique_ptr<std::atomic<std::uint64_t>[]> buckets;
+	std::atomic<std::uint64_t> count{ 0 };
+	std::atomic<double> sum{ 0.0 };
+};
+
+class MetricsRegistry {
+public:
+	static MetricsRegistry& instance();
+
+	Counter& counter(const std::string& name);
+	Gauge& gauge(const std::string& name);
+	Histogram& histogram(const std::string& name, const std::vector<double>& bounds);
+
+	void snapshot(std::string& line, const double timestamp) const;
+
+private:
+	template<typename T>
+	struct Named {
+		std::string name;
+		T metric;
+	};
+
+	mutable std::mutex registration;
+	std::vector<std::unique_ptr<Named<Counter>>> counters;
+	std::vector<std::unique_ptr<Named<Gauge>>> gauges;
+	std::vector<std::unique_ptr<Named<Histogram>>> histograms;
+
+	MetricsRegistry() = default;
+};
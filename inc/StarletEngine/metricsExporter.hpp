@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MetricsRegistry;
+
+class MetricsExporter {
+public:
+	MetricsExporter() = default;
+	~MetricsExporter() { stop(); }
+
+	MetricsExporter(const MetricsExporter&) = delete;
+	MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+	bool startFile(const std::string& path, const double intervalSeconds);
+	bool startSocket(const std::string& path, const double intervalSeconds);
+	void stop();
+
+	bool isRunning() const { return worker.joinable(); }
+
+private:
+	struct Client {
+		int socket;
+		std::string pending;
+	};
+
+	static constexpr std::size_t MaxPendingBytes{ 1 << 20 };
+
+	std::FILE* file{ nullptr };
+	int listenSocket{ -1 };
+	std::vector<Client> clients;
+	std::string socketPath;
+
+	std::thread worker;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool stopping{ false };
+
+	bool start(const double intervalSeconds);
+	void exportLoop(const double intervalSeconds);
+	void publish(const std::string& line);
+	void acceptClients();
+	static bool flush(Client& client);
+	void closeSinks();
+};
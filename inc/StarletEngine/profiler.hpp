@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+struct ProfileEvent {
+	const char* name{ nullptr };
+	std::uint64_t startNs{ 0 };
+	std::uint64_t endNs{ 0 };
+};
+
+class ProfileBuffer {
+public:
+	static constexpr std::size_t Capacity{ 1 << 16 };
+
+	explicit ProfileBuffer(const unsigned int threadIdIn) : threadId(threadIdIn) {}
+
+	// Each slot carries a sequence number (odd while being written), so snapshot can run while this thread keeps
+	// recording and drops slots that were overwritten mid-read instead of exporting torn events.
+	void record(const char* name, const std::uint64_t startNs, const std::uint64_t endNs) {
+		const std::uint64_t index = head.load(std::memory_order_relaxed);
+		Slot& slot = slots[index & (Capacity - 1)];
+
+		slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.name.store(name, std::memory_order_relaxed);
+		slot.startNs.store(startNs, std::memory_order_relaxed);
+		slot.endNs.store(endNs, std::memory_order_relaxed);
+		slot.sequence.store(index * 2 + 2, std::memory_order_release);
+
+		head.store(index + 1, std::memory_order_release);
+	}
+
+	std::size_t snapshot(std::vector<ProfileEvent>& out) const;
+	void clear() { tail.store(head.load(std::memory_order_acquire), std::memory_order_release); }
+
+	unsigned int getThreadId() const { return threadId; }
+
+private:
+	struct Slot {
+		std::atomic<std::uint64_t> sequence{ 0 };
+		std::atomic<const char*> name{ nullptr };
+		std::atomic<std::uint64_t> startNs{ 0 };
+		std::atomic<std::uint64_t> endNs{ 0 };
+	};
+
+	std::array<Slot, Capacity> slots{};
+	std::atomic<std::uint64_t> head{ 0 };
+	std::atomic<std::uint64_t> tail{ 0 };
+	unsigned int threadId;
+};
+
+class Profiler {
+public:
+	static Profiler& instance();
+
+	static std::uint64_t now();
+	ProfileBuffer& threadBuffer();
+
+	const char* intern(const std::string& name);
+	void setThreadName(const std::string& name);
+
+	bool writeChromeTrace(const std::string& path);
+	void clear();
+
+private:
+	Profiler() = default;
+
+	std::mutex mutex;
+	std::vector<std::unique_ptr<ProfileBuffer>> buffers;
+	std::vector<std::pair<unsigned int, std::string>> threadNames;
+	std::unordered_set<std::string> names;
+};
+
+class ProfileZone {
+public:
+	explicit ProfileZone(const char* nameIn) : name(nameIn), buffer(Profiler::instance().threadBuffer()), startNs(Profiler::now()) {}
+	~ProfileZone() { buffer.record(name, startNs, Profiler::now()); }
+
+	ProfileZone(const ProfileZone&) = delete;
+	ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+	const char* name;
+	ProfileBuffer& buffer;
+	std::uint64_t startNs;
+};
+
+#define STARLET_PROFILE_CONCAT_INNER(a, b) a##b
+#define STARLET_PROFILE_CONCAT(a, b) STARLET_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef STARLET_PROFILER
+#define STARLET_PROFILE_ZONE(name) ProfileZone STARLET_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define STARLET_PROFILE_ZONE(name) ((void)0)
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Scene;
+
+enum class ResourceClass : unsigned char {
+	Mesh,
+	Texture,
+	Count
+};
+
+struct ResourceUsage {
+	ResourceClass type{ ResourceClass::Mesh };
+	std::string key;
+	std::size_t cpuBytes{ 0 };
+	std::size_t gpuBytes{ 0 };
+};
+
+struct ResourceResidencyHooks {
+	std::function<void(Scene&, std::vector<ResourceUsage>&)> collect;
+	std::function<bool(const ResourceUsage&)> evict;
+};
+
+class ResourceResidency {
+public:
+	static constexpr std::size_t ClassCount{ static_cast<std::size_t>(ResourceClass::Count) };
+
+	void setHooks(ResourceResidencyHooks hooksIn) { hooks = std::move(hooksIn); }
+	bool hasHooks() const { return static_cast<bool>(hooks.collect); }
+
+	// With no budget set, resources are freed as soon as no scene references them; a budget keeps them cached up to that size.
+	void setBudget(const std::size_t cpuBytes, const std::size_t gpuBytes);
+	std::size_t getCpuBudget() const { return cpuBudget; }
+	std::size_t getGpuBudget() const { return gpuBudget; }
+
+	std::vector<ResourceUsage> collect(Scene& scene) const;
+	void acquire(const std::vector<ResourceUsage>& usages);
+	void release(const std::vector<ResourceUsage>& usages);
+	std::size_t enforceBudget();
+
+	std::size_t getResidentCpuBytes(const ResourceClass type) const { return resident[index(type)].cpuBytes; }
+	std::size_t getResidentGpuBytes(const ResourceClass type) const { return resident[index(type)].gpuBytes; }
+	std::size_t getResidentCount(const ResourceClass type) const { return resident[index(type)].count; }
+	std::size_t getTotalCpuBytes() const;
+	std::size_t getTotalGpuBytes() const;
+	std::size_t getCachedCount() const { return unreferenced.size(); }
+	std::size_t getEvictions() const { return evictions; }
+
+private:
+	struct Entry {
+		ResourceUsage usage;
+		unsigned int references{ 0 };
+		std::list<std::string>::iterator lruPosition;
+	};
+
+	struct ClassTotals {
+		std::size_t cpuBytes{ 0 };
+		std::size_t gpuBytes{ 0 };
+		std::size_t count{ 0 };
+	};
+
+	ResourceResidencyHooks hooks;
+	std::unordered_map<std::string, Entry> entries;
+	std::list<std::string> unreferenced;
+	std::array<ClassTotals, ClassCount> resident{};
+
+	std::size_t cpuBudget{ 0 };
+	std::size_t gpuBudget{ 0 };
+	std::size_t evictions{ 0 };
+
+	static std::size_t index(const ResourceClass type) { return static_cast<std::size_t>(type); }
+	static std::string entryKey(const ResourceUsage& usage);
+	bool overBudget() const;
+};
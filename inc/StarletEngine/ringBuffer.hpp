@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+template<typename T, std::size_t Capacity>
+class RingBuffer {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+public:
+	class View {
+	public:
+		class Iterator {
+		public:
+			Iterator(const T* dataIn, std::size_t indexIn) : data(dataIn), index(indexIn) {}
+
+			const T& operator*() const { return data[index & (Capacity - 1)]; }
+			const T* operator->() const { return &data[index & (Capacity - 1)]; }
+			Iterator& operator++() { ++index; return *this; }
+			bool operator!=(const Iterator& other) const { return index != other.index; }
+			bool operator==(const Iterator& other) const { return index == other.index; }
+
+		private:
+			const T* data;
+			std::size_t index;
+		};
+
+		View(const T* dataIn, std::size_t headIn, std::size_t tailIn) : data(dataIn), head(headIn), tail(tailIn) {}
+
+		Iterator begin() const { return Iterator(data, head); }
+		Iterator end()   const { return Iterator(data, tail); }
+
+		std::size_t size() const { return tail - head; }
+		bool empty() const { return head == tail; }
+		const T& operator[](const std::size_t i) const { return data[(head + i) & (Capacity - 1)]; }
+
+	private:
+		const T* data;
+		std::size_t head;
+		std::size_t tail;
+	};
+
+	bool push(const T& value) {
+		if (tail - head == Capacity) {
+			++dropped;
+			return false;
+		}
+
+		data[tail & (Capacity - 1)] = value;
+		++tail;
+		return true;
+	}
+
+	View view() const { return View(data.data(), head, tail); }
+	void clear() { head = tail; }
+
+	std::size_t size() const { return tail - head; }
+	bool empty() const { return head == tail; }
+	std::size_t getDropped() const { return dropped; }
+	static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+	std::array<T, Capacity> data{};
+	std::size_t head{ 0 };
+	std::size_t tail{ 0 };
+	std::size_t dropped{ 0 };
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "StarletEngine/cookedScene.hpp"
+#include "StarletScene/scene.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class SceneCooker {
+public:
+	using Write = std::function<void(const void*, std::vector<unsigned char>&)>;
+	using Read = std::function<bool(Scene&, const Entity, const unsigned char*, const std::size_t)>;
+
+	template<typename T>
+	void addComponent(const char* name) {
+		static_assert(std::is_trivially_copyable<T>::value, "Components that own memory need explicit write/read codecs");
+		addComponent<T>(name,
+			[](const void* component, std::vector<unsigned char>& out) {
+				const unsigned char* bytes = static_cast<const unsigned char*>(component);
+				out.insert(out.end(), bytes, bytes + sizeof(T));
+			},
+			[](Scene& scene, const Entity entity, const unsigned char* data, const std::size_t size) {
+				if (size != sizeof(T)) return false;
+				std::memcpy(static_cast<void*>(&scene.addComponent<T>(entity)), data, sizeof(T));
+				return true;
+			});
+	}
+
+	template<typename T>
+	void addComponent(const char* name, Write write, Read read) {
+		Codec codec;
+		codec.name = name;
+		codec.layout = { sizeof(T), alignof(T) };
+		codec.entities = [](Scene& scene) { return scene.getEntitiesOfType<T>(); };
+		codec.get = [](Scene& scene, const Entity entity) -> const void* { return scene.getComponent<T>(entity); };
+		codec.write = std::move(write);
+		codec.read = std::move(read);
+		codecs.push_back(std::move(codec));
+	}
+
+	// Cooks a component member by member: strings are length-prefixed, arrays go element by element and anything else
+	// must be trivially copyable. If the listed members leave a gap in T that padding cannot explain, a member is
+	// missing from the list and the component stays unsupported rather than being cooked without it.
+	template<typename T, typename... Members>
+	void addFields(const char* name, Members T::*... members) {
+		const T sample{};
+		const unsigned char* base = reinterpret_cast<const unsigned char*>(&sample);
+		std::vector<Member> fields{ { static_cast<std::size_t>(reinterpret_cast<const unsigned char*>(&(sample.*members)) - base),
+			sizeof(Members), alignof(Members) }... };
+
+		if (!coversLayout(fields, sizeof(T), alignof(T))) {
+			addUnsupported<T>(name);
+			return;
+		}
+
+		std::vector<std::size_t> layout{ sizeof(T), alignof(T) };
+		for (const Member& field : fields) layout.insert(layout.end(), { field.offset, field.size });
+
+		addComponent<T>(name,
+			[members...](const void* component, std::vector<unsigned char>& out) {
+				const T& value = *static_cast<const T*>(component);
+				(writeField(out, value.*members), ...);
+			},
+			[members...](Scene& scene, const Entity entity, const unsigned char* data, const std::size_t size) {
+				T value{};
+				FieldReader reader{ data, size };
+				if (!(readField(reader, value.*members) && ...) || reader.offset != size) return false;
+				scene.addComponent<T>(entity) = std::move(value);
+				return true;
+			});
+		codecs.back().layout = std::move(layout);
+	}
+
+	// Registers a component the scene may hold but that cannot be cooked yet, so cooking fails loudly instead of dropping it.
+	template<typename T>
+	void addUnsupported(const char* name) {
+		Codec codec;
+		codec.name = name;
+		codec.layout = { sizeof(T), alignof(T) };
+		codec.entities = [](Scene& scene) { return scene.getEntitiesOfType<T>(); };
+		codecs.push_back(std::move(codec));
+	}
+
+	template<typename T>
+	void addDefault(const char* name) {
+		if constexpr (std::is_trivially_copyable<T>::value) addComponent<T>(name);
+		else addUnsupported<T>(name);
+	}
+
+	bool cook(Scene& scene, std::vector<unsigned char>& payload) const;
+	bool restore(Scene& scene, const unsigned char* data, const std::size_t size) const;
+	std::uint64_t getLayoutHash() const;
+
+	static SceneCookHooks makeHooks(std::shared_ptr<const SceneCooker> cooker);
+	static std::shared_ptr<SceneCooker> createDefault();
+
+private:
+	struct Codec {
+		std::string name;
+		std::vector<std::size_t> layout;
+		std::function<std::vector<Entity>(Scene&)> entities;
+		std::function<const void*(Scene&, const Entity)> get;
+		Write write;
+		Read read;
+	};
+
+	struct Member {
+		std::size_t offset;
+		std::size_t size;
+		std::size_t align;
+	};
+
+	static bool coversLayout(std::vector<Member> members, const std::size_t size, const std::size_t align);
+
+	struct FieldReader {
+		const unsigned char* data;
+		std::size_t size;
+		std::size_t offset{ 0 };
+	};
+
+	static void writeField(std::vector<unsigned char>& out, const std::string& value);
+	static bool readField(FieldReader& reader, std::string& value);
+
+	template<typename U, std::size_t N>
+	static void writeField(std::vector<unsigned char>& out, const U (&values)[N]) {
+		for (const U& value : values) writeField(out, value);
+	}
+	template<typename U, std::size_t N>
+	static bool readField(FieldReader& reader, U (&values)[N]) {
+		for (U& value : values)
+			if (!readField(reader, value)) return false;
+		return true;
+	}
+
+	template<typename U>
+	static void writeField(std::vector<unsigned char>& out, const U& value) {
+		static_assert(std::is_trivially_copyable<U>::value, "Members that own memory need their own writeField overload");
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+		out.insert(out.end(), bytes, bytes + sizeof(U));
+	}
+	template<typename U>
+	static bool readField(FieldReader& reader, U& value) {
+		static_assert(std::is_trivially_copyable<U>::value, "Members that own memory need their own readField overload");
+		if (reader.size - reader.offset < sizeof(U)) return false;
+		std::memcpy(static_cast<void*>(&value), reader.data + reader.offset, sizeof(U));
+		reader.offset += sizeof(U);
+		return true;
+	}
+
+	std::vector<Codec> codecs;
+};
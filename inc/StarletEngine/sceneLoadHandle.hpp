@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+
+struct SceneLoadProgress {
+	explicit SceneLoadProgress(const unsigned int totalStepsIn) : totalSteps(totalStepsIn), future(promise.get_future().share()) {}
+
+	void setStage(const char* name) { stage.store(name, std::memory_order_release); }
+	void advance() { completedSteps.fetch_add(1, std::memory_order_acq_rel); }
+	void finish(const bool success) {
+		bool expected = false;
+		if (!finishing.compare_exchange_strong(expected, true)) return;
+		succeeded.store(success, std::memory_order_release);
+		setStage(success ? "ready" : "failed");
+		done.store(true, std::memory_order_release);
+		promise.set_value(success);
+	}
+
+	const unsigned int totalSteps;
+	std::atomic<unsigned int> completedSteps{ 0 };
+	std::atomic<const char*> stage{ "queued" };
+	std::atomic<bool> finishing{ false };
+	std::atomic<bool> done{ false };
+	std::atomic<bool> succeeded{ false };
+
+	std::promise<bool> promise;
+	std::shared_future<bool> future;
+};
+
+class SceneLoadHandle {
+public:
+	SceneLoadHandle() = default;
+	explicit SceneLoadHandle(std::shared_ptr<SceneLoadProgress> progressIn) : progress(std::move(progressIn)) {}
+
+	bool valid()     const { return progress != nullptr; }
+	bool isDone()    const { return progress && progress->done.load(std::memory_order_acquire); }
+	bool succeeded() const { return progress && progress->succeeded.load(std::memory_order_acquire); }
+
+	const char* getStage() const { return progress ? progress->stage.load(std::memory_order_acquire) : "invalid"; }
+	float getProgress() const {
+		if (!progress || progress->totalSteps == 0) return 0.0f;
+		return static_cast<float>(progress->completedSteps.load(std::memory_order_acquire)) / static_cast<float>(progress->totalSteps);
+	}
+
+	std::shared_future<bool> getFuture() const { return progress ? progress->future : std::shared_future<bool>(); }
+
+private:
+	std::shared_ptr<SceneLoadProgress> progress;
+};
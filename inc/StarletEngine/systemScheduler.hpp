@@ -0,0 +1,51 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+class Scene;
+class InputManager;
+class ThreadPool;
+
+using ComponentSet = std::vector<std::type_index>;
+
+template<typename... Ts>
+ComponentSet componentSet() { return { std::type_index(typeid(Ts))... }; }
+
+class SystemScheduler {
+public:
+	using UpdateFn = std::function<void(Scene&, InputManager&, const float)>;
+
+	template<typename T>
+	void addSystem(const std::string& name, ComponentSet reads, ComponentSet writes) {
+		std::shared_ptr<T> system = std::make_shared<T>();
+		addSystem(name, std::move(reads), std::move(writes),
+			[system](Scene& scene, InputManager& input, const float deltaTime) { system->update(scene, input, deltaTime); });
+	}
+	void addSystem(const std::string& name, ComponentSet reads, ComponentSet writes, UpdateFn update);
+	void clear();
+
+	void update(Scene& scene, InputManager& input, const float deltaTime, ThreadPool& pool);
+
+	std::size_t getSystemCount() const { return systems.size(); }
+	std::size_t getBatchCount();
+
+private:
+	struct SystemEntry {
+		std::string name;
+		const char* profileName;
+		ComponentSet reads;
+		ComponentSet writes;
+		UpdateFn update;
+	};
+
+	std::vector<SystemEntry> systems;
+	std::vector<std::vector<std::size_t>> batches;
+	bool dirty{ false };
+
+	static bool conflicts(const SystemEntry& a, const SystemEntry& b);
+	void build();
+};
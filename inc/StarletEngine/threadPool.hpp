@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct TaskGroup {
+	std::atomic<unsigned int> remaining{ 0 };
+};
+
+class ThreadPool {
+public:
+	using Task = std::function<void()>;
+
+	explicit ThreadPool(unsigned int threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	unsigned int getThreadCount() const { return static_cast<unsigned int>(workers.size()); }
+
+	void submit(Task task);
+	void run(TaskGroup& group, Task task);
+	void wait(TaskGroup& group);
+
+	void parallelFor(const std::size_t count, const std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body);
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+
+	std::atomic<bool> stopping{ false };
+	std::atomic<unsigned int> pending{ 0 };
+	std::atomic<unsigned int> nextQueue{ 0 };
+
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+
+	void workerLoop(const unsigned int index);
+	bool tryRunOne(const int ownIndex);
+	bool popLocal(const unsigned int index, Task& out);
+	bool steal(const unsigned int thief, Task& out);
+};
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <chrono>
+
 class Timer {
 public:
 	Timer();
 
-	float tick();
+	double tick();
+	double elapsed() const;
 
 private:
-	  float lastTime;
-};
\ No newline at end of file
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point startTime;
+	Clock::time_point lastTime;
+	bool started{ false };
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+class UploadQueue {
+public:
+	using Task = std::function<void()>;
+
+	explicit UploadQueue(const std::size_t capacityIn = 16) : capacity(capacityIn > 0 ? capacityIn : 1) {}
+
+	bool push(Task task);
+	std::size_t drain(const std::size_t maxTasks);
+	void close();
+
+	std::size_t size() const;
+
+private:
+	mutable std::mutex mutex;
+	std::condition_variable notFull;
+	std::deque<Task> tasks;
+	std::size_t capacity;
+	bool closed{ false };
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <functional>
+
+class Scene;
+class Window;
+
+class Viewport {
+public:
+	using CameraSelector = std::function<void(Scene&)>;
+
+	Viewport(Window& windowIn, CameraSelector selectCameraIn) : window(windowIn), selectCamera(std::move(selectCameraIn)) {}
+	~Viewport() = default;
+
+	Viewport(const Viewport&) = delete;
+	Viewport& operator=(const Viewport&) = delete;
+
+	Window& getWindow() const { return window; }
+	float   getAspect() const;
+	bool    shouldClose() const;
+
+	void prepareScene(Scene& scene) const { if (selectCamera) selectCamera(scene); }
+
+	bool begin();
+	void present(Window& mainWindow);
+	void destroy(Window& mainWindow);
+
+private:
+	Window& window;
+	CameraSelector selectCamera;
+
+	unsigned int framebuffer{ 0 };
+	unsigned int colorTexture{ 0 };
+	unsigned int depthBuffer{ 0 };
+	unsigned int presentFramebuffer{ 0 };
+	unsigned int targetWidth{ 0 }, targetHeight{ 0 };
+
+	bool resizeTarget(const unsigned int width, const unsigned int height);
+	void releaseTarget();
+};
@@ -8,7 +8,7 @@ public:
 	Window() = default;
 	~Window();
 
-	bool createWindow(const unsigned int widthIn, const unsigned int heightIn, const char* title);
+	bool createWindow(const unsigned int widthIn, const unsigned int heightIn, const char* title, GLFWwindow* share = nullptr);
 
 	GLFWwindow* getGLFWwindow() const { return window; }
 	bool shouldClose() const;
@@ -25,6 +25,7 @@ public:
 	void setCurrentWindow() const;
 
 	void updateViewport(const unsigned int width, const unsigned int height);
+	void bindViewport() const;
 
 	bool switchActiveWindowVisibility();
 	bool switchCursorLock();
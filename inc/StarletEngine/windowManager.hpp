@@ -1,32 +1,60 @@
 #pragma once
 
 #include "window.hpp"
+#include "framePacer.hpp"
+
 #include <memory>
+#include <vector>
 
 class WindowManager {
 public:
   WindowManager();
   ~WindowManager();
 
+  bool init(const bool headless = false);
+
+  void setContextVersion(const int major, const int minor) { glMajor = major; glMinor = minor; }
+  void setPacingMode(const PacingMode mode);
+  int  getSwapInterval() const { return swapInterval; }
+
+  Window*      getMainWindow() const { return activeWindow.get(); }
 	GLFWwindow* getGLFWwindow() const { return activeWindow ? activeWindow->getGLFWwindow() : nullptr; }
   unsigned int getWidth()      const { return activeWindow ? activeWindow->getWidth() : 0; }
   unsigned int getHeight()     const { return activeWindow ? activeWindow->getHeight() : 0; }
   float        getAspect()     const { return activeWindow ? static_cast<float>(activeWindow->getWidth()) / static_cast<float>(activeWindow->getHeight()) : -1.0f; }
 
   bool createWindow(const unsigned int width, const unsigned int height, const char* title);
+  Window* createSharedWindow(const unsigned int width, const unsigned int height, const char* title);
+  void destroyWindow(Window* window);
+  Window* findWindow(GLFWwindow* window) const;
+  GLFWwindow* getInputWindow();
   bool shouldClose() const { return activeWindow ? activeWindow->shouldClose() : true; }
 
   void pollEvents()   const { if (activeWindow) activeWindow->pollEvents(); }
   void swapBuffers()  const { if (activeWindow) activeWindow->swapBuffers(); }
   void requestClose() const { if (activeWindow) activeWindow->requestClose(); }
 
-  void setWindowPointer(void* userPointer) const { if (activeWindow) activeWindow->setWindowPointer(userPointer); }
+  void setWindowPointer(void* userPointerIn);
 
-  void updateViewport(const unsigned int width, const unsigned int height) { if (activeWindow) activeWindow->updateViewport(width, height); }
+  void updateViewport(GLFWwindow* window, const unsigned int width, const unsigned int height) { if (Window* target = findWindow(window)) target->updateViewport(width, height); }
+  void bindMainViewport() const { if (activeWindow) activeWindow->bindViewport(); }
 
   bool switchActiveWindowVisibility() const { return activeWindow ? activeWindow->switchActiveWindowVisibility() : false; }
   bool switchCursorLock() const { return activeWindow ? activeWindow->switchCursorLock() : false; }
 
 private:
   std::unique_ptr<Window> activeWindow;
+  std::vector<std::unique_ptr<Window>> sharedWindows;
+  GLFWwindow* inputWindow{ nullptr };
+  void* userPointer{ nullptr };
+  bool initialized{ false };
+
+  int glMajor{ 3 };
+  int glMinor{ 3 };
+  PacingMode pacingMode{ PacingMode::Vsync };
+  int swapInterval{ 1 };
+
+  void applySwapInterval();
+
+  void installCallbacks(GLFWwindow* window) const;
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "StarletEngine/assetCache.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+  constexpr char CacheMagic[4]{ 'S', 'A', 'C', 'H' };
+  constexpr std::uint64_t FnvOffset{ 14695981039346656037ull };
+  constexpr std::uint64_t FnvPrime{ 1099511628211ull };
+
+  std::uint64_t hashBytes(const unsigned char* data, const std::size_t size, std::uint64_t hash) {
+    for (std::size_t i = 0; i < size; ++i) {
+      hash ^= data[i];
+      hash *= FnvPrime;
+    }
+    return hash;
+  }
+
+  std::uint64_t hashValue(const std::uint64_t value, const std::uint64_t hash) {
+    unsigned char bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    return hashBytes(bytes, sizeof(bytes), hash);
+  }
+}
+
+bool AssetCache::computeKey(const AssetRequest& request, std::uint64_t& key) {
+  MappedFile source;
+  if (!source.open(request.sourcePath)) return false;
+
+  std::uint64_t hash = hashBytes(source.getData(), source.getSize(), FnvOffset);
+  hash = hashValue(source.getSize(), hash);
+  hash = hashValue(static_cast<std::uint64_t>(request.type), hash);
+  hash = hashValue(Version, hash);
+  key = hashBytes(reinterpret_cast<const unsigned char*>(request.importSettings.data()), request.importSettings.size(), hash);
+  return true;
+}
+
+std::string AssetCache::entryPath(const std::uint64_t key) const {
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+  return (std::filesystem::path(directory) / (std::string(name) + ".bin")).string();
+}
+
+bool AssetCache::fetch(const std::uint64_t key, const ResourceClass type, MappedFile& file) const {
+  const std::string path = entryPath(key);
+
+  std::error_code errorCode;
+  if (!std::filesystem::exists(path, errorCode)) return false;
+  if (!file.open(path)) return false;
+  if (file.getSize() < sizeof(Header)) return debugLog("AssetCache", "fetch", path + " is truncated, ignoring", false);
+
+  Header header{};
+  std::memcpy(&header, file.getData(), sizeof(header));
+  if (std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0 || header.version != Version)
+    return debugLog("AssetCache", "fetch", path + " has an unsupported format, ignoring", false);
+  if (header.key != key || header.type != static_cast<std::uint32_t>(type))
+    return debugLog("AssetCache", "fetch", path + " belongs to a different asset, ignoring", false);
+  if (header.payloadSize != file.getSize() - sizeof(Header))
+    return debugLog("AssetCache", "fetch", path + " payload size mismatch, ignoring", false);
+
+  return true;
+}
+
+bool AssetCache::store(const std::uint64_t key, const ResourceClass type, const std::vector<unsigned char>& payload) {
+  std::error_code errorCode;
+  std::filesystem::create_directories(directory, errorCode);
+  if (errorCode) return error("AssetCache", "store", "Failed to create cache directory " + directory);
+
+  Header header{};
+  std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+  header.version = Version;
+  header.type = static_cast<std::uint32_t>(type);
+  header.key = key;
+  header.payloadSize = payload.size();
+
+  const std::string path = entryPath(key);
+  const std::string temporaryPath = path + "." + std::to_string(nextTemporary.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!file) return error("AssetCache", "store", "Failed to open " + temporaryPath);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    if (!file) return error("AssetCache", "store", "Failed to write " + temporaryPath);
+  }
+
+  std::filesystem::rename(temporaryPath, path, errorCode);
+  if (errorCode) {
+    std::filesystem::remove(temporaryPath, errorCode);
+    return error("AssetCache", "store", "Failed to publish " + path);
+  }
+
+  bytesWritten.fetch_add(sizeof(header) + payload.size(), std::memory_order_relaxed);
+  return true;
+}
+
+bool AssetCache::load(const AssetRequest& request, const AssetCacheHooks& hooks) {
+  if (!hooks.upload) return error("AssetCache", "load", "Missing upload hook");
+
+  PreparedAsset prepared;
+  if (!prepare(request, hooks, prepared)) return false;
+  return hooks.upload(request, prepared.data, prepared.size);
+}
+
+bool AssetCache::prepare(const AssetRequest& request, const AssetCacheHooks& hooks, PreparedAsset& prepared) {
+  if (!hooks.decode) return error("AssetCache", "prepare", "Missing decode hook");
+  prepared.request = request;
+
+  std::uint64_t key = 0;
+  const bool keyed = isEnabled() && computeKey(request, key);
+
+  if (keyed && fetch(key, request.type, prepared.cached)) {
+    hits.fetch_add(1, std::memory_order_relaxed);
+    bytesRead.fetch_add(prepared.cached.getSize(), std::memory_order_relaxed);
+    prepared.data = prepared.cached.getData() + sizeof(Header);
+    prepared.size = prepared.cached.getSize() - sizeof(Header);
+    return true;
+  }
+  prepared.cached.close();
+
+  if (isEnabled()) misses.fetch_add(1, std::memory_order_relaxed);
+  if (!hooks.decode(request, prepared.decoded)) return error("AssetCache", "prepare", "Failed to decode " + request.sourcePath);
+
+  if (keyed && !store(key, request.type, prepared.decoded))
+    debugLog("AssetCache", "prepare", "Continuing without caching " + request.sourcePath);
+
+  prepared.data = prepared.decoded.data();
+  prepared.size = prepared.decoded.size();
+  return true;
+}
+
+AssetCacheStats AssetCache::getStats() const {
+  AssetCacheStats stats;
+  stats.hits = hits.load(std::memory_order_relaxed);
+  stats.misses = misses.load(std::memory_order_relaxed);
+  stats.bytesRead = bytesRead.load(std::memory_order_relaxed);
+  stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void AssetCache::resetStats() {
+  hits.store(0, std::memory_order_relaxed);
+  misses.store(0, std::memory_order_relaxed);
+  bytesRead.store(0, std::memory_order_relaxed);
+  bytesWritten.store(0, std::memory_order_relaxed);
+}
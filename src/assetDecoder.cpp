@@ -0,0 +1,390 @@
+#include "StarletEngine/assetDecoder.hpp"
+#include "StarletEngine/assetStore.hpp"
+#include "StarletEngine/mappedFile.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+  constexpr std::size_t Floats = AssetStore::MeshVertexFloats;
+
+  std::string lowerExtension(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+  }
+
+  std::uint16_t readU16(const unsigned char* data) { return static_cast<std::uint16_t>(data[0] | (data[1] << 8)); }
+  std::uint32_t readU32(const unsigned char* data) { return static_cast<std::uint32_t>(data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<std::uint32_t>(data[3]) << 24)); }
+
+  struct ObjCorner {
+    int position, uv, normal;
+    bool operator==(const ObjCorner& other) const { return position == other.position && uv == other.uv && normal == other.normal; }
+  };
+
+  struct ObjCornerHash {
+    std::size_t operator()(const ObjCorner& corner) const {
+      return (static_cast<std::size_t>(corner.position) * 73856093u) ^ (static_cast<std::size_t>(corner.uv) * 19349663u) ^ (static_cast<std::size_t>(corner.normal) * 83492791u);
+    }
+  };
+
+  int resolveObjIndex(const int index, const std::size_t count) {
+    if (index > 0) return index - 1;
+    if (index < 0) return static_cast<int>(count) + index;
+    return -1;
+  }
+
+  bool parseObjCorner(const std::string& token, const std::size_t positions, const std::size_t uvs, const std::size_t normals, ObjCorner& corner) {
+    int values[3]{ 0, 0, 0 };
+    std::size_t field = 0, start = 0;
+    for (std::size_t i = 0; i <= token.size() && field < 3; ++i) {
+      if (i < token.size() && token[i] != '/') continue;
+      if (i > start) values[field] = std::atoi(token.c_str() + start);
+      ++field;
+      start = i + 1;
+    }
+
+    corner.position = resolveObjIndex(values[0], positions);
+    corner.uv = resolveObjIndex(values[1], uvs);
+    corner.normal = resolveObjIndex(values[2], normals);
+    return corner.position >= 0 && corner.position < static_cast<int>(positions)
+      && corner.uv < static_cast<int>(uvs) && corner.normal < static_cast<int>(normals);
+  }
+}
+
+bool AssetDecoder::canDecode(const ResourceClass type, const std::string& path) {
+  const std::string extension = lowerExtension(path);
+  if (type == ResourceClass::Mesh) return extension == ".obj" || extension == ".ply";
+  return extension == ".tga" || extension == ".bmp";
+}
+
+bool AssetDecoder::decode(const AssetRequest& request, std::vector<unsigned char>& payload) {
+  const std::string extension = lowerExtension(request.sourcePath);
+  if (request.type == ResourceClass::Mesh) {
+    if (extension == ".obj") return decodeObj(request.sourcePath, payload);
+    if (extension == ".ply") return decodePly(request.sourcePath, payload);
+  }
+  else {
+    if (extension == ".tga") return decodeTga(request.sourcePath, payload);
+    if (extension == ".bmp") return decodeBmp(request.sourcePath, payload);
+  }
+  return error("AssetDecoder", "decode", "No built-in decoder for " + request.sourcePath);
+}
+
+void AssetDecoder::writeMesh(const std::vector<float>& vertices, const std::vector<std::uint32_t>& indices, std::vector<unsigned char>& payload) {
+  const MeshPayloadHeader header{ static_cast<std::uint32_t>(vertices.size() / Floats), static_cast<std::uint32_t>(indices.size()) };
+  const std::size_t vertexBytes = vertices.size() * sizeof(float);
+  const std::size_t indexBytes = indices.size() * sizeof(std::uint32_t);
+
+  payload.resize(sizeof(header) + vertexBytes + indexBytes);
+  std::memcpy(payload.data(), &header, sizeof(header));
+  if (vertexBytes > 0) std::memcpy(payload.data() + sizeof(header), vertices.data(), vertexBytes);
+  if (indexBytes > 0) std::memcpy(payload.data() + sizeof(header) + vertexBytes, indices.data(), indexBytes);
+}
+
+void AssetDecoder::computeNormals(std::vector<float>& vertices, const std::vector<std::uint32_t>& indices) {
+  for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+    float* a = &vertices[indices[i] * Floats];
+    float* b = &vertices[indices[i + 1] * Floats];
+    float* c = &vertices[indices[i + 2] * Floats];
+
+    const float e1[3]{ b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    const float e2[3]{ c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    const float normal[3]{ e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+    for (float* vertex : { a, b, c })
+      for (int axis = 0; axis < 3; ++axis) vertex[3 + axis] += normal[axis];
+  }
+
+  for (std::size_t v = 0; v < vertices.size(); v += Floats) {
+    float* normal = &vertices[v + 3];
+    const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    if (length > 0.0f)
+      for (int axis = 0; axis < 3; ++axis) normal[axis] /= length;
+  }
+}
+
+bool AssetDecoder::decodeObj(const std::string& path, std::vector<unsigned char>& payload) {
+  std::ifstream file(path);
+  if (!file) return error("AssetDecoder", "decodeObj", "Failed to open " + path);
+
+  std::vector<float> positions, uvs, normals;
+  std::vector<float> vertices;
+  std::vector<std::uint32_t> indices;
+  std::unordered_map<ObjCorner, std::uint32_t, ObjCornerHash> corners;
+  std::vector<std::uint32_t> face;
+
+  std::string line, keyword, token;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line);
+    if (!(stream >> keyword)) continue;
+
+    if (keyword == "v") {
+      float x = 0.0f, y = 0.0f, z = 0.0f;
+      stream >> x >> y >> z;
+      positions.insert(positions.end(), { x, y, z });
+    }
+    else if (keyword == "vt") {
+      float u = 0.0f, v = 0.0f;
+      stream >> u >> v;
+      uvs.insert(uvs.end(), { u, v });
+    }
+    else if (keyword == "vn") {
+      float x = 0.0f, y = 0.0f, z = 0.0f;
+      stream >> x >> y >> z;
+      normals.insert(normals.end(), { x, y, z });
+    }
+    else if (keyword == "f") {
+      face.clear();
+      while (stream >> token) {
+        ObjCorner corner{};
+        if (!parseObjCorner(token, positions.size() / 3, uvs.size() / 2, normals.size() / 3, corner))
+          return error("AssetDecoder", "decodeObj", "Invalid face index " + token + " in " + path);
+
+        auto found = corners.find(corner);
+        if (found == corners.end()) {
+          const std::uint32_t index = static_cast<std::uint32_t>(vertices.size() / Floats);
+          const float* p = &positions[corner.position * 3];
+          vertices.insert(vertices.end(), { p[0], p[1], p[2], 0.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+          if (corner.normal >= 0) std::memcpy(&vertices[index * Floats + 3], &normals[corner.normal * 3], 3 * sizeof(float));
+          if (corner.uv >= 0) std::memcpy(&vertices[index * Floats + 6], &uvs[corner.uv * 2], 2 * sizeof(float));
+          found = corners.emplace(corner, index).first;
+        }
+        face.push_back(found->second);
+      }
+
+      for (std::size_t i = 2; i < face.size(); ++i)
+        indices.insert(indices.end(), { face[0], face[i - 1], face[i] });
+    }
+  }
+
+  if (indices.empty()) return error("AssetDecoder", "decodeObj", "No faces in " + path);
+  if (normals.empty()) computeNormals(vertices, indices);
+
+  writeMesh(vertices, indices, payload);
+  return true;
+}
+
+bool AssetDecoder::decodePly(const std::string& path, std::vector<unsigned char>& payload) {
+  std::ifstream file(path);
+  if (!file) return error("AssetDecoder", "decodePly", "Failed to open " + path);
+
+  struct Element {
+    std::string name;
+    std::size_t count;
+    std::vector<std::string> properties;
+  };
+
+  std::vector<Element> elements;
+  std::string line, word;
+  if (!std::getline(file, line) || line.compare(0, 3, "ply") != 0) return error("AssetDecoder", "decodePly", path + " is not a PLY file");
+
+  while (std::getline(file, line)) {
+    std::istringstream stream(line);
+    if (!(stream >> word)) continue;
+
+    if (word == "format") {
+      stream >> word;
+      if (word != "ascii") return error("AssetDecoder", "decodePly", "Only ASCII PLY is supported: " + path);
+    }
+    else if (word == "element") {
+      Element element{};
+      stream >> element.name >> element.count;
+      elements.push_back(element);
+    }
+    else if (word == "property" && !elements.empty()) {
+      std::string type, name;
+      stream >> type;
+      if (type == "list") stream >> word >> word;
+      stream >> name;
+      elements.back().properties.push_back(name);
+    }
+    else if (word == "end_header") break;
+  }
+
+  std::vector<float> vertices;
+  std::vector<std::uint32_t> indices;
+  bool hasNormals = false;
+
+  for (const Element& element : elements) {
+    if (element.name == "vertex") {
+      int slots[Floats];
+      std::fill(std::begin(slots), std::end(slots), -1);
+      for (std::size_t i = 0; i < element.properties.size(); ++i) {
+        static const char* names[Floats][3]{
+          { "x", "", "" }, { "y", "", "" }, { "z", "", "" },
+          { "nx", "", "" }, { "ny", "", "" }, { "nz", "", "" },
+          { "u", "s", "texture_u" }, { "v", "t", "texture_v" } };
+        for (std::size_t slot = 0; slot < Floats; ++slot)
+          for (const char* name : names[slot])
+            if (*name && element.properties[i] == name) slots[slot] = static_cast<int>(i);
+      }
+      hasNormals = slots[3] >= 0 && slots[4] >= 0 && slots[5] >= 0;
+
+      std::vector<float> values(element.properties.size());
+      vertices.resize(element.count * Floats, 0.0f);
+      for (std::size_t v = 0; v < element.count; ++v) {
+        for (float& value : values)
+          if (!(file >> value)) return error("AssetDecoder", "decodePly", "Truncated vertex data in " + path);
+        for (std::size_t slot = 0; slot < Floats; ++slot)
+          if (slots[slot] >= 0) vertices[v * Floats + slot] = values[slots[slot]];
+      }
+    }
+    else if (element.name == "face") {
+      std::vector<std::uint32_t> face;
+      for (std::size_t f = 0; f < element.count; ++f) {
+        std::size_t count = 0;
+        if (!(file >> count)) return error("AssetDecoder", "decodePly", "Truncated face data in " + path);
+
+        face.resize(count);
+        for (std::uint32_t& index : face)
+          if (!(file >> index) || index >= vertices.size() / Floats) return error("AssetDecoder", "decodePly", "Invalid face index in " + path);
+        for (std::size_t i = 2; i < face.size(); ++i)
+          indices.insert(indices.end(), { face[0], face[i - 1], face[i] });
+        for (std::size_t extra = 1; extra < element.properties.size(); ++extra) file >> word;
+      }
+    }
+    else {
+      file >> std::ws;
+      for (std::size_t skipped = 0; skipped < element.count; ++skipped) std::getline(file, line);
+    }
+  }
+
+  if (indices.empty()) return error("AssetDecoder", "decodePly", "No faces in " + path);
+  if (!hasNormals) computeNormals(vertices, indices);
+
+  writeMesh(vertices, indices, payload);
+  return true;
+}
+
+void AssetDecoder::writeTexture(const unsigned int width, const unsigned int height, std::vector<unsigned char>& texels, std::vector<unsigned char>& payload) {
+  TexturePayloadHeader header{ width, height, 1 };
+  while ((std::max(width, height) >> header.levels) > 0) ++header.levels;
+
+  payload.assign(reinterpret_cast<const unsigned char*>(&header), reinterpret_cast<const unsigned char*>(&header) + sizeof(header));
+  payload.insert(payload.end(), texels.begin(), texels.end());
+
+  unsigned int sourceWidth = width, sourceHeight = height;
+  for (std::uint32_t level = 1; level < header.levels; ++level) {
+    const unsigned int levelWidth = std::max(sourceWidth >> 1, 1u);
+    const unsigned int levelHeight = std::max(sourceHeight >> 1, 1u);
+    std::vector<unsigned char> next(static_cast<std::size_t>(levelWidth) * levelHeight * 4);
+
+    for (unsigned int y = 0; y < levelHeight; ++y)
+      for (unsigned int x = 0; x < levelWidth; ++x)
+        for (unsigned int channel = 0; channel < 4; ++channel) {
+          const unsigned int x0 = std::min(x * 2, sourceWidth - 1), x1 = std::min(x * 2 + 1, sourceWidth - 1);
+          const unsigned int y0 = std::min(y * 2, sourceHeight - 1), y1 = std::min(y * 2 + 1, sourceHeight - 1);
+          const unsigned int sum = texels[(static_cast<std::size_t>(y0) * sourceWidth + x0) * 4 + channel] + texels[(static_cast<std::size_t>(y0) * sourceWidth + x1) * 4 + channel]
+            + texels[(static_cast<std::size_t>(y1) * sourceWidth + x0) * 4 + channel] + texels[(static_cast<std::size_t>(y1) * sourceWidth + x1) * 4 + channel];
+          next[(static_cast<std::size_t>(y) * levelWidth + x) * 4 + channel] = static_cast<unsigned char>((sum + 2) / 4);
+        }
+
+    payload.insert(payload.end(), next.begin(), next.end());
+    texels.swap(next);
+    sourceWidth = levelWidth;
+    sourceHeight = levelHeight;
+  }
+}
+
+bool AssetDecoder::decodeTga(const std::string& path, std::vector<unsigned char>& payload) {
+  MappedFile file;
+  if (!file.open(path)) return error("AssetDecoder", "decodeTga", "Failed to open " + path);
+  if (file.getSize() < 18) return error("AssetDecoder", "decodeTga", path + " is truncated");
+
+  const unsigned char* data = file.getData();
+  const unsigned int imageType = data[2];
+  const unsigned int width = readU16(data + 12), height = readU16(data + 14);
+  const unsigned int bytesPerPixel = data[16] / 8u;
+  const bool topDown = (data[17] & 0x20) != 0;
+  const bool rle = imageType == 10 || imageType == 11;
+  const bool grey = imageType == 3 || imageType == 11;
+
+  if (data[1] != 0 || !(imageType == 2 || imageType == 3 || rle))
+    return error("AssetDecoder", "decodeTga", "Unsupported TGA type in " + path);
+  if (width == 0 || height == 0 || (grey ? bytesPerPixel != 1 : (bytesPerPixel != 3 && bytesPerPixel != 4)))
+    return error("AssetDecoder", "decodeTga", "Unsupported TGA pixel format in " + path);
+
+  const std::size_t pixels = static_cast<std::size_t>(width) * height;
+  std::vector<unsigned char> texels(pixels * 4);
+  std::size_t offset = 18 + data[0];
+
+  const auto writePixel = [&](const std::size_t pixel, const unsigned char* source) {
+    const std::size_t x = pixel % width, y = pixel / width;
+    unsigned char* target = &texels[((topDown ? height - 1 - y : y) * width + x) * 4];
+    if (grey) target[0] = target[1] = target[2] = source[0];
+    else {
+      target[0] = source[2];
+      target[1] = source[1];
+      target[2] = source[0];
+    }
+    target[3] = bytesPerPixel == 4 ? source[3] : 255;
+  };
+
+  for (std::size_t pixel = 0; pixel < pixels;) {
+    std::size_t run = 1;
+    bool repeat = false;
+    if (rle) {
+      if (offset >= file.getSize()) return error("AssetDecoder", "decodeTga", path + " is truncated");
+      const unsigned char packet = data[offset++];
+      run = (packet & 0x7f) + 1u;
+      repeat = (packet & 0x80) != 0;
+    }
+
+    run = std::min(run, pixels - pixel);
+    const std::size_t needed = (repeat ? 1 : run) * bytesPerPixel;
+    if (offset + needed > file.getSize()) return error("AssetDecoder", "decodeTga", path + " is truncated");
+
+    for (std::size_t i = 0; i < run; ++i)
+      writePixel(pixel + i, data + offset + (repeat ? 0 : i * bytesPerPixel));
+    offset += needed;
+    pixel += run;
+  }
+
+  writeTexture(width, height, texels, payload);
+  return true;
+}
+
+bool AssetDecoder::decodeBmp(const std::string& path, std::vector<unsigned char>& payload) {
+  MappedFile file;
+  if (!file.open(path)) return error("AssetDecoder", "decodeBmp", "Failed to open " + path);
+  if (file.getSize() < 54 || file.getData()[0] != 'B' || file.getData()[1] != 'M')
+    return error("AssetDecoder", "decodeBmp", path + " is not a BMP file");
+
+  const unsigned char* data = file.getData();
+  const std::uint32_t pixelOffset = readU32(data + 10);
+  const std::int32_t rawWidth = static_cast<std::int32_t>(readU32(data + 18));
+  const std::int32_t rawHeight = static_cast<std::int32_t>(readU32(data + 22));
+  const unsigned int bytesPerPixel = readU16(data + 28) / 8u;
+  const std::uint32_t compression = readU32(data + 30);
+
+  if ((compression != 0 && !(compression == 3 && bytesPerPixel == 4)) || (bytesPerPixel != 3 && bytesPerPixel != 4) || rawWidth <= 0 || rawHeight == 0)
+    return error("AssetDecoder", "decodeBmp", "Only uncompressed 24/32-bit BMP is supported: " + path);
+
+  const unsigned int width = static_cast<unsigned int>(rawWidth);
+  const unsigned int height = static_cast<unsigned int>(rawHeight < 0 ? -rawHeight : rawHeight);
+  const std::size_t stride = (static_cast<std::size_t>(width) * bytesPerPixel + 3) & ~static_cast<std::size_t>(3);
+  if (pixelOffset + stride * height > file.getSize()) return error("AssetDecoder", "decodeBmp", path + " is truncated");
+
+  std::vector<unsigned char> texels(static_cast<std::size_t>(width) * height * 4);
+  for (unsigned int row = 0; row < height; ++row) {
+    const unsigned char* source = data + pixelOffset + stride * row;
+    unsigned char* target = &texels[static_cast<std::size_t>(rawHeight < 0 ? height - 1 - row : row) * width * 4];
+    for (unsigned int x = 0; x < width; ++x, source += bytesPerPixel, target += 4) {
+      target[0] = source[2];
+      target[1] = source[1];
+      target[2] = source[0];
+      target[3] = bytesPerPixel == 4 ? source[3] : 255;
+    }
+  }
+
+  writeTexture(width, height, texels, payload);
+  return true;
+}
@@ -0,0 +1,90 @@
+#include "StarletEngine/assetStore.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+  std::size_t textureBytes(const TexturePayloadHeader& header) {
+    std::size_t bytes = 0;
+    for (std::uint32_t level = 0; level < header.levels; ++level)
+      bytes += static_cast<std::size_t>(std::max(header.width >> level, 1u)) * std::max(header.height >> level, 1u) * 4;
+    return bytes;
+  }
+}
+
+std::string AssetStore::key(const ResourceClass type, const std::string& name) {
+  return std::to_string(static_cast<unsigned int>(type)) + ":" + name;
+}
+
+bool AssetStore::validate(const ResourceClass type, const unsigned char* data, const std::size_t size) {
+  if (type == ResourceClass::Mesh) {
+    MeshPayloadHeader header{};
+    if (size < sizeof(header)) return false;
+    std::memcpy(&header, data, sizeof(header));
+
+    return size == sizeof(header) + static_cast<std::size_t>(header.vertexCount) * MeshVertexFloats * sizeof(float)
+      + static_cast<std::size_t>(header.indexCount) * sizeof(std::uint32_t);
+  }
+
+  TexturePayloadHeader header{};
+  if (size < sizeof(header)) return false;
+  std::memcpy(&header, data, sizeof(header));
+
+  return header.width > 0 && header.height > 0 && header.levels > 0 && header.levels <= 32
+    && size == sizeof(header) + textureBytes(header);
+}
+
+bool AssetStore::upload(const AssetRequest& request, const unsigned char* data, const std::size_t size) {
+  if (!validate(request.type, data, size))
+    return error("AssetStore", "upload", "Malformed payload for " + request.sourcePath);
+
+  // Backends key resources by name, so a replaced asset is freed before its successor takes the name.
+  const std::string assetKey = key(request.type, request.name);
+  auto existing = assets.find(assetKey);
+  if (existing != assets.end()) {
+    if (backend.release) backend.release(existing->second.type, existing->second.name, existing->second.asset);
+    assets.erase(existing);
+  }
+
+  Entry entry{ request.type, request.name, {} };
+  if (!backend.upload || !backend.upload(request, data, size, entry.asset))
+    return error("AssetStore", "upload", "Failed to upload " + request.sourcePath);
+
+  assets.emplace(assetKey, entry);
+  ++uploads;
+  return true;
+}
+
+bool AssetStore::release(const ResourceUsage& usage) {
+  auto found = assets.find(key(usage.type, usage.key));
+  if (found == assets.end()) return debugLog("AssetStore", "release", usage.key + " is not resident", false);
+
+  if (backend.release) backend.release(found->second.type, usage.key, found->second.asset);
+  assets.erase(found);
+  ++released;
+  return true;
+}
+
+void AssetStore::releaseAll() {
+  for (const std::pair<const std::string, Entry>& asset : assets)
+    if (backend.release) backend.release(asset.second.type, asset.second.name, asset.second.asset);
+  released += assets.size();
+  assets.clear();
+}
+
+bool AssetStore::getUsage(const AssetRequest& request, ResourceUsage& usage) const {
+  const GpuAsset* asset = find(request.type, request.name);
+  if (!asset) return false;
+
+  usage.type = request.type;
+  usage.key = request.name;
+  usage.cpuBytes = 0;
+  usage.gpuBytes = asset->gpuBytes;
+  return true;
+}
+
+const GpuAsset* AssetStore::find(const ResourceClass type, const std::string& name) const {
+  const auto found = assets.find(key(type, name));
+  return found != assets.end() ? &found->second.asset : nullptr;
+}
@@ -16,7 +16,7 @@ void key_callback(GLFWwindow* window, const int key, const int scanCode, const i
 void framebuffer_size_callback(GLFWwindow* window, const int width, const int height) {
 	Engine* engine = static_cast<Engine*>(glfwGetWindowUserPointer(window));
 	if (!engine) return;
-	engine->updateViewport(width, height);
+	engine->updateViewport(window, width, height);
 }
 void scroll_callback(GLFWwindow* window, const double xOffset, const double yOffset) {
 	Engine* engine = static_cast<Engine*>(glfwGetWindowUserPointer(window));
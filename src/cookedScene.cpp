@@ -0,0 +1,78 @@
+#include "StarletEngine/cookedScene.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+  constexpr char CookedMagic[4]{ 'S', 'C', 'K', 'D' };
+}
+
+bool CookedScene::fingerprint(const std::string& sourcePath, std::uint64_t& size, std::int64_t& time) {
+  std::error_code errorCode;
+  size = static_cast<std::uint64_t>(std::filesystem::file_size(sourcePath, errorCode));
+  if (errorCode) return false;
+
+  const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(sourcePath, errorCode);
+  if (errorCode) return false;
+
+  time = static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+  return true;
+}
+
+bool CookedScene::write(const std::string& cookedPath, const std::string& sourcePath, const std::uint64_t layout, const std::vector<unsigned char>& payload) {
+  Header header{};
+  std::memcpy(header.magic, CookedMagic, sizeof(CookedMagic));
+  header.version = Version;
+  header.layout = layout;
+  header.payloadSize = payload.size();
+  if (!fingerprint(sourcePath, header.sourceSize, header.sourceTime))
+    return error("CookedScene", "write", "Failed to stat source scene " + sourcePath);
+
+  const std::string temporaryPath = cookedPath + ".tmp";
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!file) return error("CookedScene", "write", "Failed to open " + temporaryPath);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    if (!file) return error("CookedScene", "write", "Failed to write " + temporaryPath);
+  }
+
+  std::error_code errorCode;
+  std::filesystem::rename(temporaryPath, cookedPath, errorCode);
+  if (errorCode) {
+    std::filesystem::remove(temporaryPath, errorCode);
+    return error("CookedScene", "write", "Failed to publish " + cookedPath);
+  }
+
+  return debugLog("CookedScene", "write", "Cooked " + sourcePath + " into " + cookedPath + " (" + std::to_string(payload.size()) + " bytes)");
+}
+
+bool CookedScene::open(const std::string& cookedPath, const std::string& sourcePath, const std::uint64_t layout) {
+  std::error_code errorCode;
+  if (!std::filesystem::exists(cookedPath, errorCode)) return false;
+
+  std::uint64_t sourceSize = 0;
+  std::int64_t sourceTime = 0;
+  if (!fingerprint(sourcePath, sourceSize, sourceTime)) return false;
+
+  if (!file.open(cookedPath)) return false;
+  if (file.getSize() < sizeof(Header)) return debugLog("CookedScene", "open", cookedPath + " is truncated, ignoring", false);
+
+  Header header{};
+  std::memcpy(&header, file.getData(), sizeof(header));
+  if (std::memcmp(header.magic, CookedMagic, sizeof(CookedMagic)) != 0 || header.version != Version)
+    return debugLog("CookedScene", "open", cookedPath + " has an unsupported format, ignoring", false);
+  if (header.layout != layout)
+    return debugLog("CookedScene", "open", cookedPath + " was cooked with different component layouts, falling back to " + sourcePath, false);
+  if (header.sourceSize != sourceSize || header.sourceTime != sourceTime)
+    return debugLog("CookedScene", "open", cookedPath + " is stale, falling back to " + sourcePath, false);
+  if (header.payloadSize != file.getSize() - sizeof(Header))
+    return debugLog("CookedScene", "open", cookedPath + " payload size mismatch, ignoring", false);
+
+  payload = file.getData() + sizeof(Header);
+  payloadSize = static_cast<std::size_t>(header.payloadSize);
+  return true;
+}
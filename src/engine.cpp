@@ -1,7 +1,14 @@
 #include "StarletEngine/engine.hpp"
+#include "StarletEngine/metrics.hpp"
+#include "StarletEngine/sceneCooker.hpp"
+#include "StarletEngine/assetDecoder.hpp"
 
 #include "StarletScene/components/model.hpp"
 #include "StarletScene/components/textureData.hpp"
+#include "StarletScene/components/camera.hpp"
+#include "StarletScene/components/light.hpp"
+#include "StarletScene/components/transform.hpp"
+#include "StarletScene/components/velocity.hpp"
 
 #include "StarletScene/systems/cameraMoveSystem.hpp"
 #include "StarletScene/systems/cameraLookSystem.hpp"
@@ -9,17 +16,77 @@
 #include "StarletScene/systems/velocitySystem.hpp"
 
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
 
-Engine::Engine() : renderer(resourceManager), resourceLoader(resourceManager) {}
+namespace {
+  struct EngineMetrics {
+    Counter& frames;
+    Counter& steps;
+    Gauge& frameMs;
+    Histogram& frameMsHistogram;
+
+    Counter& inputEvents;
+    Counter& inputDropped;
+    Histogram& eventsPerFrame;
+
+    Counter& loadStages;
+    Histogram& loadStageMs;
+    Counter& cacheHits;
+    Counter& cacheMisses;
+  };
+
+  EngineMetrics& metrics() {
+    static MetricsRegistry& registry = MetricsRegistry::instance();
+    static EngineMetrics engineMetrics{
+      registry.counter("frames"),
+      registry.counter("simulation.steps"),
+      registry.gauge("frame.ms"),
+      registry.histogram("frame.ms", { 1.0, 2.0, 4.0, 8.0, 16.7, 33.3, 50.0, 100.0, 250.0 }),
+      registry.counter("input.events"),
+      registry.counter("input.dropped"),
+      registry.histogram("input.eventsPerFrame", { 0.0, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0, 128.0, 256.0 }),
+      registry.counter("load.stages"),
+      registry.histogram("load.stageMs", { 1.0, 5.0, 10.0, 50.0, 100.0, 500.0, 1000.0, 5000.0 }),
+      registry.counter("assetCache.hits"),
+      registry.counter("assetCache.misses"),
+    };
+    return engineMetrics;
+  }
+}
+
+Engine::Engine() : sceneCookHooks(SceneCooker::makeHooks(SceneCooker::createDefault())), sceneManager(std::make_shared<SceneManager>()), renderer(resourceManager), resourceLoader(resourceManager) {
+  residency.setHooks(engineResidencyHooks());
+  assetStore.setBackend(rendererAssetBackend());
+}
+Engine::~Engine() {
+  uploadQueue.close();
+
+  if (Window* mainWindow = windowManager.getMainWindow())
+    for (const std::unique_ptr<Viewport>& viewport : viewports)
+      viewport->destroy(*mainWindow);
+  viewports.clear();
+  assetStore.releaseAll();
+}
 
 void Engine::setAssetPaths(const std::string& path) {
-  glState.setBasePath((path + "/shaders/").c_str());
+  assetPath = path;
+  shaderPath = path + "/shaders/";
+
+  glState.setBasePath(shaderPath.c_str());
   resourceManager.setBasePath(path);
-  sceneManager.setBasePath((path + "/scenes/").c_str());
+
+  scenePath = path + "/scenes/";
+  if (!assetCache.isEnabled()) assetCache.setDirectory(path + "/cache/");
+  sceneManager->setBasePath(scenePath.c_str());
 }
 
 bool Engine::initialize(const unsigned int width, const unsigned int height, const char* title) {
-  debugLog("Engine", "initialize", "Start time: " + std::to_string(glfwGetTime()));
+  STARLET_PROFILE_ZONE("initialize");
 
   if (!windowManager.createWindow(width, height, title)) 
     return error("Engine", "initialize", "Failed to initialize window");
@@ -31,74 +98,1032 @@ bool Engine::initialize(const unsigned int width, const unsigned int height, con
     return error("Engine", "initialize", "Failed to setup shaders for renderer");
 
   windowManager.setWindowPointer(this);
-  return debugLog("Engine", "initialize", "Finish Time: " + std::to_string(glfwGetTime()));
+  return debugLog("Engine", "initialize", "Initialized " + std::to_string(width) + " x " + std::to_string(height) + " window");
+}
+
+bool Engine::addViewport(const unsigned int width, const unsigned int height, const char* title, Viewport::CameraSelector selectCamera) {
+  if (headless) return error("Engine", "addViewport", "Viewports need a window, engine was initialized headless");
+
+  Window* window = windowManager.createSharedWindow(width, height, title);
+  if (!window) return error("Engine", "addViewport", "Failed to create viewport window");
+
+  viewports.push_back(std::make_unique<Viewport>(*window, std::move(selectCamera)));
+  return debugLog("Engine", "addViewport", "Added viewport: " + std::string(title));
+}
+
+bool Engine::initializeHeadless() {
+  if (!windowManager.init(true))
+    return error("Engine", "initializeHeadless", "Failed to initialize GLFW without a display");
+
+  headless = true;
+  return debugLog("Engine", "initializeHeadless", "Running without window, GL context or renderer");
 }
 
 bool Engine::loadScene(const std::string& sceneIn) {
-  debugLog("Engine", "loadScene", "Start time: " + std::to_string(glfwGetTime()));
+  STARLET_PROFILE_ZONE("loadScene");
+  loadTimings.clear();
+
+  const std::string sceneName = sceneIn.empty() ? "EmptyScene" : sceneIn;
+
+  std::shared_ptr<const CookedScene> cooked;
+  const double parseStart = timer.elapsed();
+  std::shared_ptr<SceneManager> loaded = parseScene(sceneIn, getLoadSettings(), cooked);
+  if (!loaded) return false;
+  loadTimings.push_back({ "parseScene", timer.elapsed() - parseStart });
+
+  for (const LoadStage& stage : getLoadStages())
+    if (!(cooked && stage.cpuSide) && !(headless && !stage.cpuSide) && !runLoadStage(stage, *loaded, sceneIn)) {
+      discardSceneAssets(*loaded);
+      return false;
+    }
+
+  activateScene(loaded, sceneName, cooked);
+  logLoadTimings(sceneIn);
+  if (headless) return debugLog("Engine", "loadScene", "Headless, skipped GPU resource stages for scene: " + sceneIn);
+  return true;
+}
+
+bool Engine::loadGeneratedScene(const std::string& name, const std::function<void(Scene&)>& generate) {
+  STARLET_PROFILE_ZONE("loadGeneratedScene");
+  loadTimings.clear();
+
+  std::shared_ptr<SceneManager> generated = createSceneManager();
+
+  const double generateStart = timer.elapsed();
+  generate(generated->getScene());
+  loadTimings.push_back({ "generateScene", timer.elapsed() - generateStart });
+
+  for (const LoadStage& stage : getLoadStages())
+    if (!(headless && !stage.cpuSide) && !runLoadStage(stage, *generated, name)) {
+      discardSceneAssets(*generated);
+      return false;
+    }
+
+  activateScene(generated, name);
+  logLoadTimings(name);
+  return true;
+}
+
+SceneLoadHandle Engine::loadSceneAsync(const std::string& sceneIn) {
+  std::vector<LoadStage> stages = getLoadStages();
+  if (headless)
+    stages.erase(std::remove_if(stages.begin(), stages.end(), [](const LoadStage& stage) { return !stage.cpuSide; }), stages.end());
+
+  std::shared_ptr<SceneLoadProgress> progress = std::make_shared<SceneLoadProgress>(static_cast<unsigned int>(stages.size()) + 2);
+
+  loadTimings.clear();
+
+  loadPool.submit([this, progress, sceneIn, stages = std::move(stages), settings = getLoadSettings()]() {
+    progress->setStage("parseScene");
+    std::shared_ptr<const CookedScene> cooked;
+    const std::chrono::steady_clock::time_point parseStart = std::chrono::steady_clock::now();
+    const std::shared_ptr<SceneManager> pending = parseScene(sceneIn, settings, cooked);
+    if (!pending) {
+      progress->finish(false);
+      return;
+    }
+    const double parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - parseStart).count();
+    progress->advance();
+
+    // Assets are decoded here, before any stage is queued, while nothing else touches the pending scene.
+    const AssetCacheStats cacheBefore = assetCache.getStats();
+    const std::chrono::steady_clock::time_point decodeStart = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<PreparedAsset>> prepared[ResourceResidency::ClassCount];
+    for (const LoadStage& stage : stages)
+      if (stage.assets != ResourceClass::Count)
+        prepared[static_cast<std::size_t>(stage.assets)] = prepareAssets(pending->getScene(), stage.assets, settings);
 
+    const AssetCacheStats cacheAfter = assetCache.getStats();
+    const LoadStageTiming decodeTiming{ "decodeAssets", std::chrono::duration<double>(std::chrono::steady_clock::now() - decodeStart).count(),
+      cacheAfter.hits - cacheBefore.hits, cacheAfter.misses - cacheBefore.misses };
+
+    for (const LoadStage& stage : stages) {
+      if (cooked && stage.cpuSide) {
+        progress->advance();
+        continue;
+      }
+
+      if (stage.assets != ResourceClass::Count)
+        for (const std::shared_ptr<PreparedAsset>& asset : prepared[static_cast<std::size_t>(stage.assets)]) {
+          const bool queued = uploadQueue.push([this, progress, asset]() {
+            if (progress->done || assetStore.find(asset->request.type, asset->request.name)) return;
+
+            STARLET_PROFILE_ZONE("uploadAsset");
+            if (!assetStore.upload(asset->request, asset->data, asset->size))
+              debugLog("Engine", "loadSceneAsync", "Leaving " + asset->request.name + " to ResourceLoader");
+          });
+          if (!queued) {
+            progress->finish(false);
+            return;
+          }
+        }
+
+      const bool queued = uploadQueue.push([this, progress, pending, sceneIn, stage]() {
+        if (progress->done) return;
+
+        progress->setStage(stage.name);
+        if (runLoadStage(stage, *pending, sceneIn)) progress->advance();
+        else {
+          discardSceneAssets(*pending);
+          progress->finish(false);
+        }
+      });
+      if (!queued) {
+        progress->finish(false);
+        return;
+      }
+    }
+
+    const bool queued = uploadQueue.push([this, progress, pending, cooked, sceneIn, parseSeconds, decodeTiming]() {
+      if (progress->done) return;
+
+      activateScene(pending, sceneIn.empty() ? "EmptyScene" : sceneIn, cooked);
+      progress->advance();
+      progress->finish(true);
+
+      loadTimings.insert(loadTimings.begin(), { { "parseScene", parseSeconds }, decodeTiming });
+      logLoadTimings(sceneIn);
+    });
+    if (!queued) progress->finish(false);
+  });
+
+  return SceneLoadHandle(progress);
+}
+
+Engine::LoadSettings Engine::getLoadSettings() const {
+  LoadSettings settings;
+  settings.scenePath = scenePath;
+  settings.assetPath = assetPath;
+  settings.sceneCookHooks = sceneCookHooks;
+  settings.assetCacheHooks = assetCacheHooks;
+  settings.assetStoreEnabled = assetStoreEnabled;
+  return settings;
+}
+
+std::shared_ptr<SceneManager> Engine::parseScene(const std::string& sceneIn, const LoadSettings& settings, std::shared_ptr<const CookedScene>& cooked) {
+  STARLET_PROFILE_ZONE("parseScene");
+
+  std::shared_ptr<SceneManager> restored = createSceneManager(settings.scenePath);
+  cooked = restoreCookedScene(*restored, sceneIn.empty() ? "EmptyScene" : sceneIn, settings);
+  if (cooked) return restored;
+
+  // A failed restore can leave entities behind, so the text scene always starts from an empty manager.
+  std::shared_ptr<SceneManager> parsed = createSceneManager(settings.scenePath);
+  if (!parseTextScene(*parsed, sceneIn)) return nullptr;
+  return parsed;
+}
+
+bool Engine::parseTextScene(SceneManager& target, const std::string& sceneIn) {
   if (sceneIn.empty()) {
-    if (!sceneManager.loadTxtScene("EmptyScene.txt"))
+    if (!target.loadTxtScene("EmptyScene.txt"))
       return error("Engine", "loadScene", "No scene loaded and failed to load Default \"EmptyScene\"");
   }
-  else if (!sceneManager.loadTxtScene(sceneIn + ".txt"))
+  else if (!target.loadTxtScene(sceneIn + ".txt"))
     return error("Engine", "loadScene", "Failed to load scene: " + sceneIn);
 
-  debugLog("ResourceLoader", "loadMeshes", "Start time: " + std::to_string(glfwGetTime()));
-  if(!resourceLoader.loadMeshes(sceneManager.getScene().getComponentsOfType<Model>()))
-		return error("Engine", "loadMeshes", "Failed to load meshes for scene: " + sceneIn);
-  debugLog("ResourceLoader", "loadMeshes", "Finish time: " + std::to_string(glfwGetTime()));
+  return true;
+}
 
-  debugLog("ResourceLoader", "loadTextures", "Start time: " + std::to_string(glfwGetTime()));
-  if(!resourceLoader.loadTextures(sceneManager.getScene().getComponentsOfType<TextureData>()))
-		return error("Engine", "loadTextures", "Failed to load textures for scene: " + sceneIn);
-  debugLog("ResourceLoader", "loadTextures", "Finish time: " + std::to_string(glfwGetTime()));
+std::shared_ptr<const CookedScene> Engine::restoreCookedScene(SceneManager& target, const std::string& sceneName, const LoadSettings& settings) {
+  const SceneCookHooks& hooks = settings.sceneCookHooks;
+  if (!hooks.restore) return nullptr;
 
-  debugLog("ResourceLoader", "processPrimitives", "Start time: " + std::to_string(glfwGetTime()));
-  if(!resourceLoader.processPrimitives(sceneManager))
-		return error("Engine", "processPrimitives", "Failed to process primitives for scene: " + sceneIn);
-  debugLog("ResourceLoader", "processPrimitives", "Finish time: " + std::to_string(glfwGetTime()));
+  std::shared_ptr<CookedScene> cooked = std::make_shared<CookedScene>();
+  if (!cooked->open(settings.scenePath + sceneName + ".cooked", settings.scenePath + sceneName + ".txt", hooks.layout)) return nullptr;
 
-  debugLog("ResourceLoader", "processGrids", "Start time: " + std::to_string(glfwGetTime()));
-  if(!resourceLoader.processGrids(sceneManager))
-		return error("Engine", "processGrids", "Failed to process grids for scene: " + sceneIn);
-  debugLog("ResourceLoader", "processGrids", "Finish time: " + std::to_string(glfwGetTime()));
+  if (!hooks.restore(target.getScene(), cooked->getPayload(), cooked->getPayloadSize())) {
+    error("Engine", "restoreCookedScene", "Failed to restore cooked scene " + sceneName + ", falling back to text");
+    return nullptr;
+  }
+
+  debugLog("Engine", "restoreCookedScene", "Restored cooked scene " + sceneName);
+  return cooked;
+}
+
+bool Engine::cookScene(const std::string& sceneIn) {
+  if (!sceneCookHooks.cook || !sceneCookHooks.restore)
+    return error("Engine", "cookScene", "No scene cook hooks registered");
+
+  const std::string sceneName = sceneIn.empty() ? "EmptyScene" : sceneIn;
+
+  SceneManager source;
+  source.setBasePath(scenePath.c_str());
+  if (!source.loadTxtScene(sceneName + ".txt"))
+    return error("Engine", "cookScene", "Failed to load scene: " + sceneName);
+
+  for (const LoadStage& stage : getLoadStages())
+    if (stage.cpuSide && !stage.run(source, sceneName))
+      return error("Engine", "cookScene", "Failed to " + std::string(stage.description) + " for scene: " + sceneName);
+
+  std::vector<unsigned char> payload;
+  if (!sceneCookHooks.cook(source.getScene(), payload))
+    return error("Engine", "cookScene", "Failed to serialise scene: " + sceneName);
+
+  return CookedScene::write(scenePath + sceneName + ".cooked", scenePath + sceneName + ".txt", sceneCookHooks.layout, payload);
+}
+
+std::vector<Engine::LoadStage> Engine::getLoadStages() {
+  return {
+    { "loadMeshes", "load meshes",
+      [this](SceneManager& target, const std::string&) {
+        std::vector<Model*> models = target.getScene().getComponentsOfType<Model>();
+        if (assetCacheHooks.collect || assetStoreEnabled) {
+          if (!loadAssets(target, ResourceClass::Mesh)) return false;
+          if (assetCacheHooks.upload) return true;
 
-  debugLog("ResourceLoader", "processTextureConnection", "Start time: " + std::to_string(glfwGetTime()));
-  if (!resourceLoader.processTextureConnections(sceneManager.getScene()))
-    return error("Engine", "processTextureConnection", "Failed to connect texture handles for scene: " + sceneIn);
-  debugLog("ResourceLoader", "processTextureConnection", "Finish time: " + std::to_string(glfwGetTime()));
+          models.erase(std::remove_if(models.begin(), models.end(),
+            [this](const Model* model) { return assetStore.find(ResourceClass::Mesh, model->meshPath) != nullptr; }), models.end());
+        }
+        return resourceLoader.loadMeshes(models);
+      }, false, ResourceClass::Mesh },
+    { "loadTextures", "load textures",
+      [this](SceneManager& target, const std::string&) {
+        std::vector<TextureData*> textures = target.getScene().getComponentsOfType<TextureData>();
+        if (assetCacheHooks.collect || assetStoreEnabled) {
+          if (!loadAssets(target, ResourceClass::Texture)) return false;
+          if (assetCacheHooks.upload) return true;
 
-  sceneManager.getScene().registerSystem(std::make_unique<CameraMoveSystem>());
-  sceneManager.getScene().registerSystem(std::make_unique<CameraLookSystem>());
-  sceneManager.getScene().registerSystem(std::make_unique<CameraFovSystem>());
-  sceneManager.getScene().registerSystem(std::make_unique<VelocitySystem>());
+          textures.erase(std::remove_if(textures.begin(), textures.end(),
+            [this](const TextureData* texture) { return assetStore.find(ResourceClass::Texture, texture->name) != nullptr; }), textures.end());
+        }
+        return resourceLoader.loadTextures(textures);
+      }, false, ResourceClass::Texture },
+    { "processPrimitives", "process primitives",
+      [this](SceneManager& target, const std::string&) { return resourceLoader.processPrimitives(target); } },
+    { "processGrids", "process grids",
+      [this](SceneManager& target, const std::string&) { return resourceLoader.processGrids(target); }, true },
+    { "processTextureConnection", "connect texture handles",
+      [this](SceneManager& target, const std::string&) { return resourceLoader.processTextureConnections(target.getScene()); } },
+  };
+}
 
-  return debugLog("Engine", "loadScene", "Finish Time: " + std::to_string(glfwGetTime()));
+namespace {
+  std::string resolveAssetPath(const std::string& path, const std::string& assetRoot) {
+    std::error_code errorCode;
+    if (std::filesystem::is_regular_file(path, errorCode)) return path;
+
+    const std::filesystem::path underRoot = std::filesystem::path(assetRoot) / path;
+    if (std::filesystem::is_regular_file(underRoot, errorCode)) return underRoot.string();
+    return std::string();
+  }
+}
+
+void Engine::addAssetRequest(const ResourceClass type, const std::string& name, const std::string& file, const std::string& root, std::vector<AssetRequest>& requests) {
+  if (name.empty() || !AssetDecoder::canDecode(type, file)) return;
+
+  const bool known = std::find_if(requests.begin(), requests.end(), [&name](const AssetRequest& request) { return request.name == name; }) != requests.end();
+  if (known) return;
+
+  const std::string path = resolveAssetPath(file, root);
+  if (path.empty()) {
+    debugLog("Engine", "collectSceneAssets", "Could not find " + file + " under " + root + ", leaving it to ResourceLoader");
+    return;
+  }
+  requests.push_back({ type, name, path, std::string() });
+}
+
+void Engine::collectSceneAssets(Scene& scene, const ResourceClass type, const std::string& root, std::vector<AssetRequest>& requests) {
+  if (type == ResourceClass::Mesh) {
+    for (const Model* model : scene.getComponentsOfType<Model>())
+      addAssetRequest(type, model->meshPath, model->meshPath, root, requests);
+    return;
+  }
+
+  for (const TextureData* texture : scene.getComponentsOfType<TextureData>())
+    if (!texture->isCube) addAssetRequest(type, texture->name, texture->faces[0], root, requests);
+}
+
+std::vector<std::shared_ptr<PreparedAsset>> Engine::prepareAssets(Scene& scene, const ResourceClass type, const LoadSettings& settings) {
+  std::vector<std::shared_ptr<PreparedAsset>> prepared;
+  if (!settings.assetStoreEnabled || settings.assetCacheHooks.upload) return prepared;
+
+  STARLET_PROFILE_ZONE("prepareAssets");
+  std::vector<AssetRequest> requests;
+  if (settings.assetCacheHooks.collect) settings.assetCacheHooks.collect(scene, type, requests);
+  else collectSceneAssets(scene, type, settings.assetPath, requests);
+
+  AssetCacheHooks hooks = settings.assetCacheHooks;
+  if (!hooks.decode) hooks.decode = &AssetDecoder::decode;
+
+  std::vector<std::shared_ptr<PreparedAsset>> slots(requests.size());
+  assetPool.parallelFor(requests.size(), 1, [this, &requests, &hooks, &slots](const std::size_t begin, const std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      std::shared_ptr<PreparedAsset> asset = std::make_shared<PreparedAsset>();
+      if (assetCache.prepare(requests[i], hooks, *asset)) slots[i] = std::move(asset);
+    }
+  });
+
+  for (std::shared_ptr<PreparedAsset>& asset : slots)
+    if (asset) prepared.push_back(std::move(asset));
+  return prepared;
+}
+
+bool Engine::loadAssets(SceneManager& target, const ResourceClass type) {
+  std::vector<AssetRequest> requests;
+  if (assetCacheHooks.collect) assetCacheHooks.collect(target.getScene(), type, requests);
+  else collectSceneAssets(target.getScene(), type, assetPath, requests);
+
+  AssetCacheHooks hooks = assetCacheHooks;
+  if (!hooks.decode) hooks.decode = &AssetDecoder::decode;
+  if (!hooks.upload)
+    hooks.upload = [this](const AssetRequest& request, const unsigned char* data, const std::size_t size) { return assetStore.upload(request, data, size); };
+
+  for (const AssetRequest& request : requests) {
+    if (!assetCacheHooks.upload && assetStore.find(request.type, request.name)) continue;
+
+    if (!assetCache.load(request, hooks)) {
+      if (assetCacheHooks.upload) return false;
+      debugLog("Engine", "loadAssets", "Leaving " + request.name + " to ResourceLoader");
+    }
+  }
+  return true;
+}
+
+AssetBackend Engine::rendererAssetBackend() {
+  AssetBackend backend;
+  backend.upload = [this](const AssetRequest& request, const unsigned char* data, const std::size_t size, GpuAsset& asset) {
+    if (request.type == ResourceClass::Mesh) {
+      MeshPayloadHeader header{};
+      std::memcpy(&header, data, sizeof(header));
+
+      const float* vertices = reinterpret_cast<const float*>(data + sizeof(header));
+      const std::uint32_t* indices = reinterpret_cast<const std::uint32_t*>(vertices + static_cast<std::size_t>(header.vertexCount) * AssetStore::MeshVertexFloats);
+      asset.count = header.indexCount;
+      asset.gpuBytes = size - sizeof(header);
+      return resourceManager.addMesh(request.name, vertices, header.vertexCount, indices, header.indexCount);
+    }
+
+    TexturePayloadHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+    asset.count = header.levels;
+    asset.gpuBytes = size - sizeof(header);
+    return resourceManager.addTexture(request.name, data + sizeof(header), header.width, header.height, header.levels);
+  };
+  backend.release = [this](const ResourceClass type, const std::string& name, const GpuAsset&) {
+    if (type == ResourceClass::Mesh) resourceManager.removeMesh(name);
+    else resourceManager.removeTexture(name);
+  };
+  return backend;
+}
+
+ResourceResidencyHooks Engine::engineResidencyHooks() {
+  ResourceResidencyHooks hooks;
+  hooks.collect = [this](Scene& scene, std::vector<ResourceUsage>& usages) {
+    std::unordered_set<std::string> seen;
+    for (const Model* model : scene.getComponentsOfType<Model>())
+      if (!model->meshPath.empty() && seen.insert(model->meshPath).second) usages.push_back(rendererUsage(ResourceClass::Mesh, model->meshPath));
+
+    seen.clear();
+    for (const TextureData* texture : scene.getComponentsOfType<TextureData>())
+      if (!texture->name.empty() && seen.insert(texture->name).second) usages.push_back(rendererUsage(ResourceClass::Texture, texture->name));
+  };
+  hooks.evict = [this](const ResourceUsage& usage) {
+    if (assetStore.find(usage.type, usage.key)) return assetStore.release(usage);
+
+    const bool removed = usage.type == ResourceClass::Mesh ? resourceManager.removeMesh(usage.key) : resourceManager.removeTexture(usage.key);
+    if (!removed) debugLog("Engine", "evict", usage.key + " was not held by ResourceManager");
+    return true;
+  };
+  return hooks;
+}
+
+ResourceUsage Engine::rendererUsage(const ResourceClass type, const std::string& name) const {
+  ResourceUsage usage;
+  usage.type = type;
+  usage.key = name;
+  if (const GpuAsset* asset = assetStore.find(type, name)) usage.gpuBytes = asset->gpuBytes;
+  return usage;
+}
+
+void Engine::discardSceneAssets(SceneManager& target) {
+  const std::vector<ResourceUsage> orphaned = residency.collect(target.getScene());
+  residency.acquire(orphaned);
+  residency.release(orphaned);
+  updateResourceMetrics();
+}
+
+bool Engine::runLoadStage(const LoadStage& stage, SceneManager& target, const std::string& sceneIn) {
+  STARLET_PROFILE_ZONE(stage.name);
+
+  const AssetCacheStats before = assetCache.getStats();
+  const double start = timer.elapsed();
+  if (!stage.run(target, sceneIn))
+    return error("Engine", stage.name, "Failed to " + std::string(stage.description) + " for scene: " + sceneIn);
+
+  const AssetCacheStats& after = assetCache.getStats();
+  const LoadStageTiming timing{ stage.name, timer.elapsed() - start, after.hits - before.hits, after.misses - before.misses };
+  loadTimings.push_back(timing);
+
+  metrics().loadStages.add();
+  metrics().loadStageMs.observe(timing.seconds * 1000.0);
+  metrics().cacheHits.add(timing.cacheHits);
+  metrics().cacheMisses.add(timing.cacheMisses);
+  return true;
+}
+
+void Engine::logLoadTimings(const std::string& sceneIn) const {
+  std::string message = "Loaded scene " + (sceneIn.empty() ? std::string("EmptyScene") : sceneIn) + ":";
+  for (const LoadStageTiming& timing : loadTimings) {
+    message += " " + std::string(timing.name) + " " + std::to_string(timing.seconds * 1000.0) + "ms";
+    if (timing.cacheHits + timing.cacheMisses > 0)
+      message += " (cache " + std::to_string(timing.cacheHits) + " hits / " + std::to_string(timing.cacheMisses) + " misses)";
+  }
+  debugLog("Engine", "loadScene", message);
+}
+
+std::shared_ptr<SceneManager> Engine::createSceneManager(const std::string& basePath) {
+  std::shared_ptr<SceneManager> created = std::make_shared<SceneManager>();
+  if (!basePath.empty()) created->setBasePath(basePath.c_str());
+  return created;
+}
+
+void Engine::activateScene(std::shared_ptr<SceneManager> next, const std::string& sceneName, std::shared_ptr<const CookedScene> cooked) {
+  std::vector<ResourceUsage> nextResources = residency.collect(next->getScene());
+  residency.acquire(nextResources);
+  residency.release(sceneResources);
+  sceneResources = std::move(nextResources);
+  updateResourceMetrics();
+
+  sceneManager = std::move(next);
+  cookedScene = std::move(cooked);
+  currentScene = sceneName;
+  createSimulationScene();
+  registerSystems();
+}
+
+namespace {
+  template<typename T>
+  void copyComponent(Scene& from, const Entity source, Scene& to, const Entity target) {
+    if (const T* component = from.getComponent<T>(source)) to.addComponent<T>(target) = *component;
+  }
+
+  template<typename T, typename Binding>
+  void captureComponents(Scene& scene, const std::vector<Binding>& bindings, std::vector<std::pair<Entity, T>>& packet) {
+    packet.clear();
+    for (const Binding& binding : bindings)
+      if (const T* component = scene.getComponent<T>(binding.simulation)) packet.emplace_back(binding.render, *component);
+  }
+
+  template<typename T>
+  void applyComponents(Scene& scene, const std::vector<std::pair<Entity, T>>& packet) {
+    for (const std::pair<Entity, T>& entry : packet)
+      if (T* component = scene.getComponent<T>(entry.first)) *component = entry.second;
+  }
+}
+
+void Engine::createSimulationScene() {
+  simulationScene.reset();
+  simulationBindings.clear();
+  if (!pipelinedFrames || headless) return;
+
+  Scene& render = sceneManager->getScene();
+  std::vector<Entity> entities = render.getEntitiesOfType<Transform>();
+  for (const std::vector<Entity>& others : { render.getEntitiesOfType<Velocity>(), render.getEntitiesOfType<Camera>(), render.getEntitiesOfType<Light>() })
+    entities.insert(entities.end(), others.begin(), others.end());
+  std::sort(entities.begin(), entities.end());
+  entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+
+  simulationScene = createSceneManager();
+  Scene& simulation = simulationScene->getScene();
+  simulationBindings.reserve(entities.size());
+  for (const Entity entity : entities) {
+    const Entity copy = simulation.createEntity();
+    copyComponent<Transform>(render, entity, simulation, copy);
+    copyComponent<Velocity>(render, entity, simulation, copy);
+    copyComponent<Camera>(render, entity, simulation, copy);
+    copyComponent<Light>(render, entity, simulation, copy);
+    simulationBindings.push_back({ copy, entity });
+  }
+}
+
+void Engine::refreshSceneResources() {
+  std::vector<ResourceUsage> refreshed = residency.collect(sceneManager->getScene());
+  residency.acquire(refreshed);
+  residency.release(sceneResources);
+  sceneResources = std::move(refreshed);
+  updateResourceMetrics();
+}
+
+void Engine::updateResourceMetrics() const {
+  static MetricsRegistry& registry = MetricsRegistry::instance();
+  static const char* classNames[ResourceResidency::ClassCount]{ "mesh", "texture" };
+
+  for (std::size_t i = 0; i < ResourceResidency::ClassCount; ++i) {
+    const ResourceClass type = static_cast<ResourceClass>(i);
+    const std::string prefix = std::string("resources.") + classNames[i];
+    registry.gauge(prefix + ".count").set(static_cast<double>(residency.getResidentCount(type)));
+    registry.gauge(prefix + ".cpuBytes").set(static_cast<double>(residency.getResidentCpuBytes(type)));
+    registry.gauge(prefix + ".gpuBytes").set(static_cast<double>(residency.getResidentGpuBytes(type)));
+  }
+
+  registry.gauge("resources.cached").set(static_cast<double>(residency.getCachedCount()));
+  registry.gauge("resources.evictions").set(static_cast<double>(residency.getEvictions()));
+}
+
+bool Engine::unloadScene() {
+  if (currentScene.empty()) return debugLog("Engine", "unloadScene", "No scene loaded", false);
+
+  const std::string unloaded = currentScene;
+  residency.release(sceneResources);
+  sceneResources.clear();
+  updateResourceMetrics();
+
+  systemScheduler.clear();
+  sceneManager = createSceneManager();
+  simulationScene.reset();
+  simulationBindings.clear();
+  cookedScene.reset();
+  currentScene.clear();
+
+  return debugLog("Engine", "unloadScene", "Unloaded scene " + unloaded + ", "
+    + std::to_string(residency.getTotalCpuBytes()) + " CPU / " + std::to_string(residency.getTotalGpuBytes()) + " GPU bytes still resident");
+}
+
+bool Engine::enableHotReload() {
+  if (assetPath.empty()) return error("Engine", "enableHotReload", "Asset paths must be set before enabling hot reload");
+  if (!fileWatcher.watch(assetPath, true)) return error("Engine", "enableHotReload", "Failed to watch " + assetPath);
+
+  return debugLog("Engine", "enableHotReload", "Watching " + assetPath + " for changes");
+}
+
+namespace {
+  bool isInside(const std::filesystem::path& file, const std::string& directory) {
+    const std::string parent = file.parent_path().lexically_normal().generic_string();
+    std::string root = std::filesystem::path(directory).lexically_normal().generic_string();
+    while (!root.empty() && root.back() == '/') root.pop_back();
+    if (root.empty() || parent.compare(0, root.size(), root) != 0) return false;
+    return parent.size() == root.size() || parent[root.size()] == '/';
+  }
+
+  bool hasExtension(const std::filesystem::path& file, std::initializer_list<const char*> extensions) {
+    std::string extension = file.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return std::find_if(extensions.begin(), extensions.end(), [&extension](const char* candidate) { return extension == candidate; }) != extensions.end();
+  }
+}
+
+void Engine::processFileChanges() {
+  constexpr double pollInterval = 0.25;
+
+  const double now = timer.elapsed();
+  if (now < nextReloadPoll) return;
+  nextReloadPoll = now + pollInterval;
+
+  STARLET_PROFILE_ZONE("processFileChanges");
+  changedPaths.clear();
+  fileWatcher.poll(changedPaths);
+  if (changedPaths.empty()) return;
+
+  const std::string sceneFile = std::filesystem::path(scenePath + currentScene + ".txt").lexically_normal().generic_string();
+  bool shadersChanged = false, sceneChanged = false;
+  std::vector<std::string> changedAssets;
+  for (const std::string& changed : changedPaths) {
+    const std::filesystem::path file(changed);
+
+    if (isInside(file, shaderPath)) shadersChanged = true;
+    else if (isInside(file, scenePath)) sceneChanged |= file.lexically_normal().generic_string() == sceneFile;
+    else if (hasExtension(file, { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".ply", ".obj" }))
+      changedAssets.push_back(file.lexically_normal().generic_string());
+  }
+
+  if (shadersChanged) reloadShaders();
+
+  if (sceneChanged) {
+    debugLog("Engine", "processFileChanges", "Scene " + currentScene + " changed, reloading");
+    loadSceneAsync(currentScene);
+    return;
+  }
+
+  if (!changedAssets.empty()) reloadAssets(changedAssets);
+}
+
+void Engine::reloadAssets(const std::vector<std::string>& changedFiles) {
+  STARLET_PROFILE_ZONE("reloadAssets");
+  Scene& scene = sceneManager->getScene();
+
+  const auto resolveChanged = [this, &changedFiles](const std::string& file) {
+    const std::string path = resolveAssetPath(file, assetPath);
+    if (path.empty()) return std::string();
+
+    const std::string normal = std::filesystem::path(path).lexically_normal().generic_string();
+    return std::find(changedFiles.begin(), changedFiles.end(), normal) != changedFiles.end() ? path : std::string();
+  };
+
+  std::unordered_set<std::string> reloaded;
+  std::vector<Model*> loaderModels;
+  for (Model* model : scene.getComponentsOfType<Model>()) {
+    const std::string path = model->meshPath.empty() ? std::string() : resolveChanged(model->meshPath);
+    if (path.empty()) continue;
+
+    if (!assetStore.find(ResourceClass::Mesh, model->meshPath)) loaderModels.push_back(model);
+    else if (reloaded.insert(model->meshPath).second) reloadStoreAsset({ ResourceClass::Mesh, model->meshPath, path, std::string() });
+  }
+
+  reloaded.clear();
+  std::vector<TextureData*> loaderTextures;
+  for (TextureData* texture : scene.getComponentsOfType<TextureData>()) {
+    const std::string path = resolveChanged(texture->faces[0]);
+    const bool faceChanged = texture->isCube && std::any_of(texture->faces + 1, texture->faces + 6,
+      [&resolveChanged](const std::string& face) { return !face.empty() && !resolveChanged(face).empty(); });
+    if (path.empty() && !faceChanged) continue;
+
+    if (!assetStore.find(ResourceClass::Texture, texture->name)) loaderTextures.push_back(texture);
+    else if (reloaded.insert(texture->name).second) reloadStoreAsset({ ResourceClass::Texture, texture->name, path, std::string() });
+  }
+
+  if (!loaderModels.empty()) {
+    for (const Model* model : loaderModels) resourceManager.removeMesh(model->meshPath);
+    if (resourceLoader.loadMeshes(loaderModels))
+      debugLog("Engine", "reloadAssets", "Reloaded " + std::to_string(loaderModels.size()) + " models through ResourceLoader");
+  }
+  if (!loaderTextures.empty()) {
+    for (const TextureData* texture : loaderTextures) resourceManager.removeTexture(texture->name);
+    if (resourceLoader.loadTextures(loaderTextures))
+      debugLog("Engine", "reloadAssets", "Reloaded " + std::to_string(loaderTextures.size()) + " textures through ResourceLoader");
+  }
+
+  if (!reloaded.empty() || !loaderTextures.empty()) resourceLoader.processTextureConnections(scene);
+  refreshSceneResources();
+}
+
+bool Engine::reloadStoreAsset(const AssetRequest& request) {
+  AssetCacheHooks hooks = assetCacheHooks;
+  if (!hooks.decode) hooks.decode = &AssetDecoder::decode;
+  hooks.upload = [this](const AssetRequest& asset, const unsigned char* data, const std::size_t size) { return assetStore.upload(asset, data, size); };
+
+  const std::size_t uploadsBefore = assetStore.getUploads();
+  if (!assetCache.load(request, hooks) || assetStore.getUploads() == uploadsBefore || !assetStore.find(request.type, request.name))
+    return error("Engine", "reloadStoreAsset", request.name + " was not re-uploaded from " + request.sourcePath);
+
+  return debugLog("Engine", "reloadStoreAsset", "Reloaded " + request.name + " from " + request.sourcePath);
+}
+
+bool Engine::reloadShaders() {
+  STARLET_PROFILE_ZONE("reloadShaders");
+
+  if (!glState.init())
+    return error("Engine", "reloadShaders", "Failed to rebuild shader program, keeping previous state");
+  if (!renderer.init(glState.getProgram()))
+    return error("Engine", "reloadShaders", "Failed to rebind renderer to the new shader program");
+
+  return debugLog("Engine", "reloadShaders", "Reloaded shaders from " + shaderPath);
+}
+
+void Engine::registerSystems() {
+  systemScheduler.clear();
+  systemScheduler.addSystem<CameraMoveSystem>("CameraMoveSystem", componentSet<InputManager>(), componentSet<Camera, Transform>());
+  systemScheduler.addSystem<CameraLookSystem>("CameraLookSystem", componentSet<InputManager>(), componentSet<Camera, Transform>());
+  systemScheduler.addSystem<CameraFovSystem>("CameraFovSystem", componentSet<InputManager>(), componentSet<Camera>());
+  systemScheduler.addSystem<VelocitySystem>("VelocitySystem", componentSet<Velocity>(), componentSet<Transform>());
+}
+
+void Engine::updateSystems(const float deltaTime) {
+  STARLET_PROFILE_ZONE("updateSystems");
+  if (simulationScene) {
+    systemScheduler.update(simulationScene->getScene(), inputManager, deltaTime, threadPool);
+    return;
+  }
+
+  Scene& scene = sceneManager->getScene();
+  systemScheduler.update(scene, inputManager, deltaTime, threadPool);
+  scene.updateSystems(inputManager, deltaTime);
+}
+
+void Engine::updateSceneSystems(const unsigned int steps) {
+  STARLET_PROFILE_ZONE("updateSceneSystems");
+  Scene& scene = sceneManager->getScene();
+  for (unsigned int i = 0; i < steps; ++i)
+    scene.updateSystems(inputManager, fixedTimestep.getStepDelta());
+}
+
+void Engine::captureTransforms() {
+  Scene& simulation = simulationScene->getScene();
+  renderPacket.transforms.clear();
+  for (const SimulationBinding& binding : simulationBindings)
+    if (const Transform* transform = simulation.getComponent<Transform>(binding.simulation))
+      renderPacket.transforms.push_back({ binding.simulation, binding.render, *transform, *transform });
+}
+
+void Engine::fillRenderPacket() {
+  STARLET_PROFILE_ZONE("fillRenderPacket");
+  Scene& simulation = simulationScene->getScene();
+  for (TransformState& state : renderPacket.transforms)
+    if (const Transform* transform = simulation.getComponent<Transform>(state.simulation)) state.current = *transform;
+  captureComponents(simulation, simulationBindings, renderPacket.cameras);
+  captureComponents(simulation, simulationBindings, renderPacket.lights);
+}
+
+void Engine::syncRenderScene() {
+  STARLET_PROFILE_ZONE("syncRenderScene");
+  Scene& scene = sceneManager->getScene();
+  const float alpha = fixedTimestep.getAlpha();
+  for (const TransformState& state : renderPacket.transforms) {
+    Transform* transform = scene.getComponent<Transform>(state.render);
+    if (!transform) continue;
+
+    *transform = state.current;
+    transform->pos = state.previous.pos + (state.current.pos - state.previous.pos) * alpha;
+    transform->size = state.previous.size + (state.current.size - state.previous.size) * alpha;
+  }
+  applyComponents(scene, renderPacket.cameras);
+  applyComponents(scene, renderPacket.lights);
+}
+
+void Engine::renderViews() {
+  Scene& scene = sceneManager->getScene();
+  Window* mainWindow = windowManager.getMainWindow();
+
+  const std::vector<Camera*> cameras = viewports.empty() ? std::vector<Camera*>() : scene.getComponentsOfType<Camera>();
+  savedCameras.clear();
+  for (const Camera* camera : cameras) savedCameras.push_back(*camera);
+
+  for (auto it = viewports.begin(); it != viewports.end();) {
+    Viewport& viewport = **it;
+    if (viewport.shouldClose()) {
+      Window* closed = &viewport.getWindow();
+      viewport.destroy(*mainWindow);
+      it = viewports.erase(it);
+      windowManager.destroyWindow(closed);
+      continue;
+    }
+
+    if (viewport.begin()) {
+      viewport.prepareScene(scene);
+      renderer.renderFrame(glState.getProgram(), scene, viewport.getAspect());
+      viewport.present(*mainWindow);
+
+      for (std::size_t i = 0; i < cameras.size(); ++i) *cameras[i] = savedCameras[i];
+    }
+    ++it;
+  }
+
+  if (mainCameraSelector) mainCameraSelector(scene);
+  renderer.renderFrame(glState.getProgram(), scene, windowManager.getAspect());
 }
 
 void Engine::run() {
+  if (headless) {
+    error("Engine", "run", "Engine was initialized headless, use runHeadless");
+    return;
+  }
+
   windowManager.switchActiveWindowVisibility();
 
+#ifdef STARLET_PROFILER
+  Profiler::instance().setThreadName("Main");
+#endif
+
+  unsigned int steps = 1;
   while (!windowManager.shouldClose()) {
-    const float deltaTime = timer.tick();
+    STARLET_PROFILE_ZONE("Frame");
+    double frameDelta = timer.tick();
+    if (frameDelta > 0.0) {
+      frameStats.addFrame(frameDelta);
+      framePacer.recordFrame(frameDelta);
 
-    inputManager.reset();
-    windowManager.pollEvents();
-    inputManager.updateMousePosition(windowManager.getGLFWwindow());
+      metrics().frames.add();
+      metrics().frameMs.set(frameDelta * 1000.0);
+      metrics().frameMsHistogram.observe(frameDelta * 1000.0);
+    }
+
+    {
+      STARLET_PROFILE_ZONE("pollEvents");
+      if (steps > 0) inputManager.reset();
+      windowManager.pollEvents();
+
+      if (inputReplay.isActive() && !replayFrame(frameDelta)) windowManager.requestClose();
+      inputManager.updateMousePosition(windowManager.getGLFWwindow());
+      recordFrame(frameDelta);
+    }
+
+    {
+      STARLET_PROFILE_ZONE("handleInput");
+      dispatchInput();
+    }
+
+    {
+      STARLET_PROFILE_ZONE("drainUploads");
+      uploadQueue.drain(uploadsPerFrame);
+    }
+
+    if (fileWatcher.isActive()) processFileChanges();
+
+    steps = fixedTimestep.advance(frameDelta);
+    metrics().steps.add(steps);
+    if (simulationScene) runPipelinedFrame(steps);
+    else {
+      simulate(steps);
+      presentFrame();
+    }
 
-    handleKeyEvents(inputManager.consumeKeyEvents());
-    handleButtonEvents(inputManager.consumeButtonEvents());
+    STARLET_PROFILE_ZONE("pace");
+    framePacer.wait();
+  }
 
-    sceneManager.getScene().updateSystems(inputManager, deltaTime);
-    renderer.renderFrame(glState.getProgram(), sceneManager.getScene(), windowManager.getAspect());
+  logFramePacing();
+}
 
+bool Engine::setFramePacing(const PacingMode mode, const double targetFps) {
+  if (!framePacer.setMode(mode, targetFps)) return false;
+
+  windowManager.setPacingMode(mode);
+  return debugLog("Engine", "setFramePacing", "Frame pacing: " + std::string(pacingModeName(mode))
+    + (mode == PacingMode::TargetFps ? " at " + std::to_string(targetFps) + " fps" : std::string()));
+}
+
+void Engine::logFramePacing() const {
+  if (frameStats.getCount() == 0) return;
+
+  const FrameStats& jitter = framePacer.getJitter();
+  debugLog("Engine", "run", "Frame pacing (" + std::string(pacingModeName(framePacer.getMode())) + "):"
+    + " p50 " + std::to_string(frameStats.getP50() * 1000.0) + "ms"
+    + " p99 " + std::to_string(frameStats.getP99() * 1000.0) + "ms"
+    + " jitter p50 " + std::to_string(jitter.getP50() * 1000.0) + "ms"
+    + " jitter p99 " + std::to_string(jitter.getP99() * 1000.0) + "ms");
+}
+
+void Engine::runPipelinedFrame(const unsigned int steps) {
+  TaskGroup simulation;
+  threadPool.run(simulation, [this, steps]() {
+    simulate(steps);
+    fillRenderPacket();
+  });
+
+  {
+    STARLET_PROFILE_ZONE("renderFrame");
+    renderViews();
+  }
+
+  {
+    STARLET_PROFILE_ZONE("swapBuffers");
     windowManager.swapBuffers();
   }
+
+  {
+    STARLET_PROFILE_ZONE("waitSimulation");
+    threadPool.wait(simulation);
+  }
+
+  syncRenderScene();
+  updateSceneSystems(steps);
+}
+
+void Engine::presentFrame() {
+  {
+    STARLET_PROFILE_ZONE("renderFrame");
+    renderViews();
+  }
+
+  STARLET_PROFILE_ZONE("swapBuffers");
+  windowManager.swapBuffers();
+}
+
+void Engine::simulate(const unsigned int steps) {
+  STARLET_PROFILE_ZONE("simulate");
+  for (unsigned int i = 0; i < steps; ++i) {
+    if (simulationScene && i + 1 == steps) captureTransforms();
+    updateSystems(fixedTimestep.getStepDelta());
+  }
+}
+
+HeadlessStats Engine::runHeadless(const unsigned int steps, const float fixedDt) {
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+
+  for (unsigned int i = 0; i < steps; ++i) {
+    STARLET_PROFILE_ZONE("HeadlessStep");
+    inputManager.reset();
+
+    recordFrame(fixedDt);
+    dispatchInput();
+
+    uploadQueue.drain(uploadsPerFrame);
+    updateSystems(fixedDt);
+  }
+
+  HeadlessStats stats;
+  stats.steps = steps;
+  stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  stats.stepsPerSecond = stats.seconds > 0.0 ? static_cast<double>(steps) / stats.seconds : 0.0;
+
+  debugLog("Engine", "runHeadless", std::to_string(steps) + " steps of " + std::to_string(fixedDt) + "s in " 
+    + std::to_string(stats.seconds) + "s (" + std::to_string(stats.stepsPerSecond) + " steps/s)");
+  return stats;
 }
 
-void Engine::handleKeyEvents(const std::vector<KeyEvent>& keyEvents) {
-  for (const KeyEvent& event : keyEvents) {
+HeadlessStats Engine::replayHeadless(const std::string& path) {
+  HeadlessStats stats;
+  if (!inputReplay.open(path)) return stats;
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+
+  unsigned int steps = 1;
+  double frameDelta = 0.0;
+  while (true) {
+    STARLET_PROFILE_ZONE("ReplayFrame");
+    if (steps > 0) inputManager.reset();
+    if (!replayFrame(frameDelta)) break;
+    inputManager.updateMousePosition(windowManager.getInputWindow());
+
+    dispatchInput();
+    uploadQueue.drain(uploadsPerFrame);
+
+    steps = fixedTimestep.advance(frameDelta);
+    simulate(steps);
+    stats.steps += steps;
+  }
+
+  stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  stats.stepsPerSecond = stats.seconds > 0.0 ? static_cast<double>(stats.steps) / stats.seconds : 0.0;
+
+  debugLog("Engine", "replayHeadless", "Replayed " + path + ": " + std::to_string(stats.steps) + " steps in "
+    + std::to_string(stats.seconds) + "s (" + std::to_string(stats.stepsPerSecond) + " steps/s)");
+  return stats;
+}
+
+bool Engine::replayFrame(double& frameDelta) {
+  const InputFrame* frame = inputReplay.next();
+  if (!frame) return debugLog("Engine", "replayFrame", "Input replay finished", false);
+
+  for (std::uint32_t i = 0; i < frame->keyCount; ++i)
+    queueKey(inputReplay.getKey(frame->firstKey + i));
+  for (std::uint32_t i = 0; i < frame->buttonCount; ++i)
+    queueButton(inputReplay.getButton(frame->firstButton + i));
+  if (frame->scrollX != 0.0 || frame->scrollY != 0.0)
+    queueScroll(frame->scrollX, frame->scrollY);
+
+  if (GLFWwindow* window = windowManager.getInputWindow())
+    glfwSetCursorPos(window, frame->cursorX, frame->cursorY);
+
+  frameDelta = frame->deltaTime;
+  return true;
+}
+
+void Engine::recordFrame(const double frameDelta) {
+  if (!inputRecorder.isActive()) return;
+
+  InputFrame frame;
+  frame.deltaTime = frameDelta;
+  frame.scrollX = frameScrollX;
+  frame.scrollY = frameScrollY;
+  if (GLFWwindow* window = windowManager.getGLFWwindow())
+    glfwGetCursorPos(window, &frame.cursorX, &frame.cursorY);
+
+  inputRecorder.writeFrame(frame, keyEvents.view(), buttonEvents.view());
+}
+
+void Engine::dispatchInput() {
+  const std::size_t events = keyEvents.view().size() + buttonEvents.view().size();
+  metrics().inputEvents.add(events);
+  metrics().eventsPerFrame.observe(static_cast<double>(events));
+  const std::size_t dropped = keyEvents.getDropped() + buttonEvents.getDropped();
+  metrics().inputDropped.add(dropped - reportedDrops);
+  reportedDrops = dropped;
+
+  if (forwardedEvents) {
+    inputManager.clearEvents();
+    forwardedEvents = false;
+  }
+
+  handleKeyEvents(keyEvents.view());
+  keyEvents.clear();
+
+  handleButtonEvents(buttonEvents.view());
+  buttonEvents.clear();
+
+  frameScrollX = 0.0;
+  frameScrollY = 0.0;
+}
+
+void Engine::queueKey(const KeyEvent& event) {
+  static_assert(GLFW_KEY_LAST < 512 && GLFW_MOUSE_BUTTON_LAST < 8, "Key state bitsets too small");
+
+  keyEvents.push(event);
+  if (event.key < 0 || event.key > GLFW_KEY_LAST || event.action == GLFW_REPEAT) return;
+
+  const bool down = event.action == GLFW_PRESS;
+  if (keysDown.test(event.key) == down) return;
+
+  keysDown.set(event.key, down);
+  inputManager.onKey(event);
+  forwardedEvents = true;
+}
+
+void Engine::queueButton(const MouseButtonEvent& event) {
+  buttonEvents.push(event);
+  if (event.button < 0 || event.button > GLFW_MOUSE_BUTTON_LAST) return;
+
+  const bool down = event.action == GLFW_PRESS;
+  if (buttonsDown.test(event.button) == down) return;
+
+  buttonsDown.set(event.button, down);
+  inputManager.onButton(event);
+  forwardedEvents = true;
+}
+
+void Engine::handleKeyEvents(const KeyEventQueue::View& events) {
+  for (const KeyEvent& event : events) {
     if (event.action != GLFW_PRESS) continue;
 
     switch (event.key) {
@@ -112,9 +1137,10 @@ void Engine::handleKeyEvents(const std::vector<KeyEvent>& keyEvents) {
   }
 }
 
-void Engine::handleButtonEvents(const std::vector<MouseButtonEvent>& buttonEvents) {
-  for (const MouseButtonEvent& event : buttonEvents) {
-    std::string buttonName;
+void Engine::handleButtonEvents(const ButtonEventQueue::View& events) {
+#ifndef NDEBUG
+  for (const MouseButtonEvent& event : events) {
+    const char* buttonName;
     switch (event.button) {
     case GLFW_MOUSE_BUTTON_LEFT:   buttonName = "Left"; break;
     case GLFW_MOUSE_BUTTON_RIGHT:  buttonName = "Right"; break;
@@ -124,13 +1150,16 @@ void Engine::handleButtonEvents(const std::vector<MouseButtonEvent>& buttonEvent
     default: buttonName = "Unknown"; break;
     }
 
-    std::string actionName;
+    const char* actionName;
     switch (event.action) {
     case GLFW_PRESS:   actionName = "Pressed"; break;
     case GLFW_RELEASE: actionName = "Released"; break;
-    default: return;
+    default: continue;
     }
 
-    debugLog("Input", "Mouse", "Button " + buttonName + " " + actionName);
+    debugLog("Input", "Mouse", std::string("Button ") + buttonName + " " + actionName);
   }
-}
\ No newline at end of file
+#else
+  (void)events;
+#endif
+}
@@ -0,0 +1,154 @@
+#include "StarletEngine/fileWatcher.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+FileWatcher::~FileWatcher() {
+  close();
+}
+
+#ifdef __linux__
+bool FileWatcher::isActive() const {
+  return inotifyFd >= 0;
+}
+
+bool FileWatcher::watch(const std::string& directory, const bool recursive) {
+  if (inotifyFd < 0) {
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) return error("FileWatcher", "watch", "Failed to initialize inotify");
+  }
+
+  if (!addWatch(directory, recursive)) return false;
+  if (!recursive) return true;
+
+  std::error_code errorCode;
+  for (std::filesystem::recursive_directory_iterator it(directory, errorCode), end; it != end; it.increment(errorCode))
+    if (it->is_directory(errorCode)) addWatch(it->path().string(), true);
+  return true;
+}
+
+bool FileWatcher::addWatch(const std::string& directory, const bool recursive) {
+  const int descriptor = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+  if (descriptor < 0) return error("FileWatcher", "addWatch", "Failed to watch " + directory);
+
+  std::string path = directory;
+  if (!path.empty() && path.back() != '/') path += '/';
+  directories[descriptor] = { path, recursive };
+  return true;
+}
+
+void FileWatcher::addCreatedDirectory(const std::string& directory, std::vector<std::string>& changedPaths) {
+  if (!addWatch(directory, true)) return;
+
+  // Files written before the watch was in place would otherwise never be reported.
+  std::error_code errorCode;
+  for (std::filesystem::recursive_directory_iterator it(directory, errorCode), end; it != end; it.increment(errorCode)) {
+    if (it->is_directory(errorCode)) addWatch(it->path().string(), true);
+    else if (it->is_regular_file(errorCode)) report(it->path().string(), changedPaths);
+  }
+}
+
+void FileWatcher::report(std::string path, std::vector<std::string>& changedPaths) {
+  if (std::find(changedPaths.begin(), changedPaths.end(), path) == changedPaths.end())
+    changedPaths.push_back(std::move(path));
+}
+
+void FileWatcher::poll(std::vector<std::string>& changedPaths) {
+  if (inotifyFd < 0) return;
+
+  alignas(inotify_event) char buffer[4096];
+  while (true) {
+    const ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+    if (length <= 0) break;
+
+    for (ssize_t offset = 0; offset < length;) {
+      const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+      if (event->mask & IN_IGNORED) {
+        directories.erase(event->wd);
+        continue;
+      }
+      if (event->len == 0) continue;
+
+      const auto directory = directories.find(event->wd);
+      if (directory == directories.end()) continue;
+
+      // IN_CREATE is only watched to discover directories; a created file is reported once it is closed or moved in.
+      const std::string path = directory->second.path + event->name;
+      if (!(event->mask & IN_ISDIR)) {
+        if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) report(path, changedPaths);
+      }
+      else if (directory->second.recursive && (event->mask & (IN_CREATE | IN_MOVED_TO))) addCreatedDirectory(path, changedPaths);
+    }
+  }
+}
+
+void FileWatcher::close() {
+  if (inotifyFd >= 0) ::close(inotifyFd);
+  inotifyFd = -1;
+  directories.clear();
+}
+#else
+bool FileWatcher::isActive() const {
+  return !roots.empty();
+}
+
+bool FileWatcher::watch(const std::string& directory, const bool recursive) {
+  std::error_code errorCode;
+  if (!std::filesystem::is_directory(directory, errorCode))
+    return error("FileWatcher", "watch", "Failed to watch " + directory);
+
+  roots.emplace_back(directory, recursive);
+  scan(nullptr);
+  return true;
+}
+
+void FileWatcher::scan(std::vector<std::string>* changedPaths) {
+  std::error_code errorCode;
+  const auto visit = [this, changedPaths, &errorCode](const std::filesystem::directory_entry& entry) {
+    if (!entry.is_regular_file(errorCode)) return;
+
+    const std::filesystem::file_time_type writeTime = entry.last_write_time(errorCode);
+    if (errorCode) return;
+
+    const std::string path = entry.path().generic_string();
+    auto known = writeTimes.find(path);
+    if (known == writeTimes.end()) {
+      writeTimes.emplace(path, writeTime);
+      if (changedPaths) changedPaths->push_back(path);
+    }
+    else if (known->second != writeTime) {
+      known->second = writeTime;
+      if (changedPaths) changedPaths->push_back(path);
+    }
+  };
+
+  for (const std::pair<std::string, bool>& root : roots) {
+    if (root.second) {
+      for (std::filesystem::recursive_directory_iterator it(root.first, errorCode), end; it != end; it.increment(errorCode))
+        visit(*it);
+    }
+    else {
+      for (std::filesystem::directory_iterator it(root.first, errorCode), end; it != end; it.increment(errorCode))
+        visit(*it);
+    }
+  }
+}
+
+void FileWatcher::poll(std::vector<std::string>& changedPaths) {
+  scan(&changedPaths);
+}
+
+void FileWatcher::close() {
+  roots.clear();
+  writeTimes.clear();
+}
+#endif
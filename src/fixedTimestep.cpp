@@ -0,0 +1,41 @@
+#include "StarletEngine/fixedTimestep.hpp"
+#include "StarletEngine/metrics.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <cmath>
+
+void FixedTimestep::setRate(const double hz, const unsigned int maxStepsIn) {
+  if (hz <= 0.0 || maxStepsIn == 0) {
+    error("FixedTimestep", "setRate", "Rate and max steps must be greater than zero");
+    return;
+  }
+
+  stepDelta = 1.0 / hz;
+  maxSteps = maxStepsIn;
+  accumulator = 0.0;
+}
+
+unsigned int FixedTimestep::advance(const double frameDelta) {
+  if (frameDelta > 0.0) accumulator += frameDelta;
+
+  unsigned int steps = 0;
+  while (accumulator >= stepDelta && steps < maxSteps) {
+    accumulator -= stepDelta;
+    ++steps;
+  }
+
+  if (accumulator >= stepDelta) {
+    const double dropped = accumulator - std::fmod(accumulator, stepDelta);
+    accumulator -= dropped;
+    droppedTime += dropped;
+    ++clampedFrames;
+
+    static Counter& clampedCounter = MetricsRegistry::instance().counter("fixedTimestep.clampedFrames");
+    static Counter& droppedMicroseconds = MetricsRegistry::instance().counter("fixedTimestep.droppedUs");
+    clampedCounter.add();
+    droppedMicroseconds.add(static_cast<std::uint64_t>(dropped * 1e6));
+    debugLog("FixedTimestep", "advance", "Hit " + std::to_string(maxSteps) + " catch-up steps, dropped " + std::to_string(dropped) + "s");
+  }
+
+  return steps;
+}
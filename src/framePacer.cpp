@@ -0,0 +1,49 @@
+#include "StarletEngine/framePacer.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <cmath>
+#include <thread>
+
+const char* pacingModeName(const PacingMode mode) {
+  switch (mode) {
+  case PacingMode::Uncapped:      return "uncapped";
+  case PacingMode::Vsync:         return "vsync";
+  case PacingMode::AdaptiveVsync: return "adaptive vsync";
+  case PacingMode::TargetFps:     return "target fps";
+  }
+  return "unknown";
+}
+
+bool FramePacer::setMode(const PacingMode modeIn, const double targetFpsIn) {
+  if (modeIn == PacingMode::TargetFps && targetFpsIn <= 0.0)
+    return error("FramePacer", "setMode", "Target FPS must be greater than zero");
+
+  mode = modeIn;
+  targetFps = modeIn == PacingMode::TargetFps ? targetFpsIn : 0.0;
+  framePeriod = targetFps > 0.0
+    ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps))
+    : Clock::duration::zero();
+  deadline = Clock::time_point{};
+  return true;
+}
+
+void FramePacer::wait() {
+  if (mode != PacingMode::TargetFps) return;
+
+  const Clock::time_point now = Clock::now();
+  if (deadline == Clock::time_point{} || now - deadline > framePeriod) {
+    deadline = now + framePeriod;
+    return;
+  }
+
+  const Clock::duration spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(spinThreshold));
+  if (deadline - now > spin) std::this_thread::sleep_for(deadline - now - spin);
+  while (Clock::now() < deadline) std::this_thread::yield();
+
+  deadline += framePeriod;
+}
+
+void FramePacer::recordFrame(const double frameSeconds) {
+  if (lastFrame > 0.0) jitter.addFrame(std::fabs(frameSeconds - lastFrame));
+  lastFrame = frameSeconds;
+}
@@ -0,0 +1,21 @@
+#include "StarletEngine/frameStats.hpp"
+
+#include <algorithm>
+
+void FrameStats::addFrame(const double seconds) {
+  samples[next] = seconds;
+  next = (next + 1) % WindowSize;
+  if (count < WindowSize) ++count;
+}
+
+double FrameStats::getPercentile(const double percentile) const {
+  if (count == 0) return 0.0;
+
+  std::array<double, WindowSize> sorted;
+  std::copy(samples.begin(), samples.begin() + count, sorted.begin());
+
+  const double clamped = std::min(std::max(percentile, 0.0), 1.0);
+  const std::size_t rank = static_cast<std::size_t>(clamped * static_cast<double>(count - 1) + 0.5);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + count);
+  return sorted[rank];
+}
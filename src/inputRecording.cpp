@@ -0,0 +1,125 @@
+#include "StarletEngine/inputRecording.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <cstring>
+
+namespace {
+  constexpr char InputMagic[4]{ 'S', 'I', 'R', 'C' };
+  constexpr std::uint32_t InputVersion{ 1 };
+
+  template<typename T>
+  void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template<typename T>
+  bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+  }
+}
+
+bool InputRecorder::open(const std::string& pathIn) {
+  close();
+
+  file.open(pathIn, std::ios::binary | std::ios::trunc);
+  if (!file) return error("InputRecorder", "open", "Failed to open " + pathIn);
+
+  file.write(InputMagic, sizeof(InputMagic));
+  writeValue(file, InputVersion);
+
+  path = pathIn;
+  frameCount = 0;
+  return debugLog("InputRecorder", "open", "Recording input to " + path);
+}
+
+void InputRecorder::close() {
+  if (!file.is_open()) return;
+
+  file.close();
+  debugLog("InputRecorder", "close", "Recorded " + std::to_string(frameCount) + " frames to " + path);
+}
+
+void InputRecorder::writeHeader(const InputFrame& frame, const std::uint16_t keyCount, const std::uint16_t buttonCount) {
+  writeValue(file, frame.deltaTime);
+  writeValue(file, frame.cursorX);
+  writeValue(file, frame.cursorY);
+  writeValue(file, frame.scrollX);
+  writeValue(file, frame.scrollY);
+  writeValue(file, keyCount);
+  writeValue(file, buttonCount);
+}
+
+void InputRecorder::writeKey(const KeyEvent& event) {
+  writeValue(file, static_cast<std::int16_t>(event.key));
+  writeValue(file, static_cast<std::uint8_t>(event.action));
+  writeValue(file, static_cast<std::uint8_t>(event.mods));
+}
+
+void InputRecorder::writeButton(const MouseButtonEvent& event) {
+  writeValue(file, static_cast<std::uint8_t>(event.button));
+  writeValue(file, static_cast<std::uint8_t>(event.action));
+  writeValue(file, static_cast<std::uint8_t>(event.mods));
+}
+
+bool InputReplay::open(const std::string& path) {
+  close();
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return error("InputReplay", "open", "Failed to open " + path);
+
+  char magic[4]{};
+  std::uint32_t version = 0;
+  if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, InputMagic, sizeof(magic)) != 0 || !readValue(file, version))
+    return error("InputReplay", "open", path + " is not an input recording");
+  if (version != InputVersion)
+    return error("InputReplay", "open", path + " has unsupported version " + std::to_string(version));
+
+  InputFrame frame;
+  while (readValue(file, frame.deltaTime)) {
+    std::uint16_t keyCount = 0, buttonCount = 0;
+    if (!readValue(file, frame.cursorX) || !readValue(file, frame.cursorY)
+     || !readValue(file, frame.scrollX) || !readValue(file, frame.scrollY)
+     || !readValue(file, keyCount)      || !readValue(file, buttonCount))
+      return error("InputReplay", "open", path + " is truncated at frame " + std::to_string(frames.size()));
+
+    frame.firstKey = static_cast<std::uint32_t>(keys.size());
+    frame.keyCount = keyCount;
+    for (std::uint16_t i = 0; i < keyCount; ++i) {
+      std::int16_t key = 0;
+      std::uint8_t action = 0, mods = 0;
+      if (!readValue(file, key) || !readValue(file, action) || !readValue(file, mods))
+        return error("InputReplay", "open", path + " is truncated at frame " + std::to_string(frames.size()));
+      keys.push_back({ key, action, mods });
+    }
+
+    frame.firstButton = static_cast<std::uint32_t>(buttons.size());
+    frame.buttonCount = buttonCount;
+    for (std::uint16_t i = 0; i < buttonCount; ++i) {
+      std::uint8_t button = 0, action = 0, mods = 0;
+      if (!readValue(file, button) || !readValue(file, action) || !readValue(file, mods))
+        return error("InputReplay", "open", path + " is truncated at frame " + std::to_string(frames.size()));
+      buttons.push_back({ button, action, mods });
+    }
+
+    frames.push_back(frame);
+  }
+
+  active = true;
+  return debugLog("InputReplay", "open", "Replaying " + std::to_string(frames.size()) + " frames from " + path);
+}
+
+void InputReplay::close() {
+  frames.clear();
+  keys.clear();
+  buttons.clear();
+  cursor = 0;
+  active = false;
+}
+
+const InputFrame* InputReplay::next() {
+  if (!active || cursor >= frames.size()) {
+    active = false;
+    return nullptr;
+  }
+  return &frames[cursor++];
+}
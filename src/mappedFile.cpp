@@ -0,0 +1,91 @@
+#include "StarletEngine/mappedFile.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string& path) {
+  close();
+
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return error("MappedFile", "open", "Failed to open " + path);
+  fileHandle = file;
+
+  LARGE_INTEGER fileSize{};
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    close();
+    return error("MappedFile", "open", "Empty or unreadable file " + path);
+  }
+
+  mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mappingHandle) {
+    close();
+    return error("MappedFile", "open", "Failed to map " + path);
+  }
+
+  data = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+  if (!data) {
+    close();
+    return error("MappedFile", "open", "Failed to map view of " + path);
+  }
+
+  size = static_cast<std::size_t>(fileSize.QuadPart);
+  return true;
+}
+
+void MappedFile::close() {
+  if (data) UnmapViewOfFile(data);
+  if (mappingHandle) CloseHandle(mappingHandle);
+  if (fileHandle) CloseHandle(fileHandle);
+
+  data = nullptr;
+  size = 0;
+  mappingHandle = nullptr;
+  fileHandle = nullptr;
+}
+#else
+bool MappedFile::open(const std::string& path) {
+  close();
+
+  fileDescriptor = ::open(path.c_str(), O_RDONLY);
+  if (fileDescriptor < 0) return error("MappedFile", "open", "Failed to open " + path);
+
+  struct stat status{};
+  if (fstat(fileDescriptor, &status) != 0 || status.st_size == 0) {
+    close();
+    return error("MappedFile", "open", "Empty or unreadable file " + path);
+  }
+
+  void* mapped = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  if (mapped == MAP_FAILED) {
+    close();
+    return error("MappedFile", "open", "Failed to map " + path);
+  }
+
+  data = static_cast<const unsigned char*>(mapped);
+  size = static_cast<std::size_t>(status.st_size);
+  return true;
+}
+
+void MappedFile::close() {
+  if (data) munmap(const_cast<unsigned char*>(data), size);
+  if (fileDescriptor >= 0) ::close(fileDescriptor);
+
+  data = nullptr;
+  size = 0;
+  fileDescriptor = -1;
+}
+#endif
@@ -0,0 +1,122 @@
+#include "StarletEngine/metrics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+  void appendNumber(std::string& line, const double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+    line += buffer;
+  }
+
+  void appendName(std::string& line, const std::string& name) {
+    line += '"';
+    for (const char c : name) {
+      if (c == '"' || c == '\\') line += '\\';
+      line += c;
+    }
+    line += "\":";
+  }
+}
+
+Histogram::Histogram(std::vector<double> boundsIn) : bounds(std::move(boundsIn)), buckets(new std::atomic<std::uint64_t>[bounds.size() + 1]) {
+  for (std::size_t i = 0; i < getBucketCount(); ++i)
+    buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void Histogram::observe(const double sample) {
+  const std::size_t index = static_cast<std::size_t>(std::lower_bound(bounds.begin(), bounds.end(), sample) - bounds.begin());
+  buckets[index].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+
+  double current = sum.load(std::memory_order_relaxed);
+  while (!sum.compare_exchange_weak(current, current + sample, std::memory_order_relaxed)) {}
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+  static MetricsRegistry registry;
+  return registry;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name) {
+  std::lock_guard<std::mutex> lock(registration);
+  for (const std::unique_ptr<Named<Counter>>& named : counters)
+    if (named->name == name) return named->metric;
+
+  counters.push_back(std::unique_ptr<Named<Counter>>(new Named<Counter>{ name, {} }));
+  return counters.back()->metric;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name) {
+  std::lock_guard<std::mutex> lock(registration);
+  for (const std::unique_ptr<Named<Gauge>>& named : gauges)
+    if (named->name == name) return named->metric;
+
+  gauges.push_back(std::unique_ptr<Named<Gauge>>(new Named<Gauge>{ name, {} }));
+  return gauges.back()->metric;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::vector<double>& bounds) {
+  std::lock_guard<std::mutex> lock(registration);
+  for (const std::unique_ptr<Named<Histogram>>& named : histograms)
+    if (named->name == name) return named->metric;
+
+  std::vector<double> sorted = bounds;
+  std::sort(sorted.begin(), sorted.end());
+  histograms.push_back(std::unique_ptr<Named<Histogram>>(new Named<Histogram>{ name, Histogram(std::move(sorted)) }));
+  return histograms.back()->metric;
+}
+
+void MetricsRegistry::snapshot(std::string& line, const double timestamp) const {
+  std::vector<const Named<Counter>*> counterList;
+  std::vector<const Named<Gauge>*> gaugeList;
+  std::vector<const Named<Histogram>*> histogramList;
+  {
+    std::lock_guard<std::mutex> lock(registration);
+    for (const std::unique_ptr<Named<Counter>>& named : counters) counterList.push_back(named.get());
+    for (const std::unique_ptr<Named<Gauge>>& named : gauges) gaugeList.push_back(named.get());
+    for (const std::unique_ptr<Named<Histogram>>& named : histograms) histogramList.push_back(named.get());
+  }
+
+  line.clear();
+  line += "{\"time\":";
+  appendNumber(line, timestamp);
+
+  line += ",\"counters\":{";
+  for (std::size_t i = 0; i < counterList.size(); ++i) {
+    if (i > 0) line += ',';
+    appendName(line, counterList[i]->name);
+    line += std::to_string(counterList[i]->metric.get());
+  }
+
+  line += "},\"gauges\":{";
+  for (std::size_t i = 0; i < gaugeList.size(); ++i) {
+    if (i > 0) line += ',';
+    appendName(line, gaugeList[i]->name);
+    appendNumber(line, gaugeList[i]->metric.get());
+  }
+
+  line += "},\"histograms\":{";
+  for (std::size_t i = 0; i < histogramList.size(); ++i) {
+    const Histogram& histogram = histogramList[i]->metric;
+    if (i > 0) line += ',';
+    appendName(line, histogramList[i]->name);
+
+    line += "{\"bounds\":[";
+    for (std::size_t b = 0; b < histogram.getBounds().size(); ++b) {
+      if (b > 0) line += ',';
+      appendNumber(line, histogram.getBounds()[b]);
+    }
+    line += "],\"buckets\":[";
+    for (std::size_t b = 0; b < histogram.getBucketCount(); ++b) {
+      if (b > 0) line += ',';
+      line += std::to_string(histogram.getBucket(b));
+    }
+    line += "],\"count\":" + std::to_string(histogram.getCount()) + ",\"sum\":";
+    appendNumber(line, histogram.getSum());
+    line += '}';
+  }
+
+  line += "}}\n";
+}
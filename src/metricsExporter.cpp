@@ -0,0 +1,179 @@
+#include "StarletEngine/metricsExporter.hpp"
+#include "StarletEngine/metrics.hpp"
+#include "StarletEngine/profiler.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+bool MetricsExporter::startFile(const std::string& path, const double intervalSeconds) {
+  stop();
+
+  file = std::fopen(path.c_str(), "a");
+  if (!file) return error("MetricsExporter", "startFile", "Failed to open " + path);
+
+  if (!start(intervalSeconds)) return false;
+  return debugLog("MetricsExporter", "startFile", "Writing metrics to " + path);
+}
+
+bool MetricsExporter::startSocket(const std::string& path, const double intervalSeconds) {
+#ifdef _WIN32
+  return error("MetricsExporter", "startSocket", "Unix socket sink is not supported on this platform, use startFile");
+#else
+  stop();
+
+  sockaddr_un address{};
+  if (path.size() >= sizeof(address.sun_path)) return error("MetricsExporter", "startSocket", "Socket path too long: " + path);
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenSocket < 0) return error("MetricsExporter", "startSocket", "Failed to create socket");
+
+  unlink(path.c_str());
+  if (bind(listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listenSocket, 4) != 0) {
+    closeSinks();
+    return error("MetricsExporter", "startSocket", "Failed to listen on " + path);
+  }
+
+  fcntl(listenSocket, F_SETFL, fcntl(listenSocket, F_GETFL, 0) | O_NONBLOCK);
+  socketPath = path;
+
+  if (!start(intervalSeconds)) return false;
+  return debugLog("MetricsExporter", "startSocket", "Serving metrics on " + path);
+#endif
+}
+
+bool MetricsExporter::start(const double intervalSeconds) {
+  if (intervalSeconds <= 0.0) {
+    closeSinks();
+    return error("MetricsExporter", "start", "Snapshot interval must be greater than zero");
+  }
+
+  stopping = false;
+  worker = std::thread(&MetricsExporter::exportLoop, this, intervalSeconds);
+  return true;
+}
+
+void MetricsExporter::stop() {
+  if (worker.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+  }
+
+  closeSinks();
+}
+
+void MetricsExporter::exportLoop(const double intervalSeconds) {
+#ifdef STARLET_PROFILER
+  Profiler::instance().setThreadName("Metrics");
+#endif
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> interval(intervalSeconds);
+  std::string line;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!wake.wait_for(lock, interval, [this]() { return stopping; })) {
+    lock.unlock();
+
+    const double timestamp = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    MetricsRegistry::instance().snapshot(line, timestamp);
+    publish(line);
+
+    lock.lock();
+  }
+}
+
+void MetricsExporter::publish(const std::string& line) {
+  if (file) {
+    std::fputs(line.c_str(), file);
+    std::fflush(file);
+  }
+
+#ifndef _WIN32
+  if (listenSocket < 0) return;
+  acceptClients();
+
+  for (auto it = clients.begin(); it != clients.end();) {
+    it->pending += line;
+    if (flush(*it) && it->pending.size() <= MaxPendingBytes) {
+      ++it;
+      continue;
+    }
+
+    close(it->socket);
+    it = clients.erase(it);
+  }
+#endif
+}
+
+bool MetricsExporter::flush(Client& client) {
+#ifndef _WIN32
+#ifdef MSG_NOSIGNAL
+  constexpr int sendFlags = MSG_NOSIGNAL | MSG_DONTWAIT;
+#else
+  constexpr int sendFlags = MSG_DONTWAIT;
+#endif
+
+  std::size_t offset = 0;
+  while (offset < client.pending.size()) {
+    const ssize_t sent = send(client.socket, client.pending.data() + offset, client.pending.size() - offset, sendFlags);
+    if (sent > 0) {
+      offset += static_cast<std::size_t>(sent);
+      continue;
+    }
+    if (sent < 0 && errno == EINTR) continue;
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+    return false;
+  }
+
+  client.pending.erase(0, offset);
+#else
+  (void)client;
+#endif
+  return true;
+}
+
+void MetricsExporter::acceptClients() {
+#ifndef _WIN32
+  for (int client = accept(listenSocket, nullptr, nullptr); client >= 0; client = accept(listenSocket, nullptr, nullptr)) {
+#ifdef SO_NOSIGPIPE
+    const int enabled = 1;
+    setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+    clients.push_back({ client, std::string() });
+  }
+#endif
+}
+
+void MetricsExporter::closeSinks() {
+  if (file) {
+    std::fclose(file);
+    file = nullptr;
+  }
+
+#ifndef _WIN32
+  for (const Client& client : clients) close(client.socket);
+  clients.clear();
+
+  if (listenSocket >= 0) {
+    close(listenSocket);
+    listenSocket = -1;
+    unlink(socketPath.c_str());
+  }
+#endif
+  socketPath.clear();
+}
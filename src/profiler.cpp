@@ -0,0 +1,113 @@
+#include "StarletEngine/profiler.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace {
+  thread_local ProfileBuffer* localBuffer{ nullptr };
+
+  void writeEscaped(std::ofstream& file, const char* text) {
+    for (const char* c = text; *c; ++c) {
+      if (*c == '"' || *c == '\\') file << '\\';
+      file << *c;
+    }
+  }
+}
+
+std::size_t ProfileBuffer::snapshot(std::vector<ProfileEvent>& out) const {
+  const std::uint64_t end = head.load(std::memory_order_acquire);
+  std::uint64_t begin = tail.load(std::memory_order_acquire);
+  if (end - begin > Capacity) begin = end - Capacity;
+
+  std::size_t copied = 0;
+  for (std::uint64_t i = begin; i < end; ++i) {
+    const Slot& slot = slots[i & (Capacity - 1)];
+    const std::uint64_t written = i * 2 + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != written) continue;
+
+    const ProfileEvent event{ slot.name.load(std::memory_order_relaxed), slot.startNs.load(std::memory_order_relaxed), slot.endNs.load(std::memory_order_relaxed) };
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != written) continue;
+
+    out.push_back(event);
+    ++copied;
+  }
+  return copied;
+}
+
+Profiler& Profiler::instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+std::uint64_t Profiler::now() {
+  static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+ProfileBuffer& Profiler::threadBuffer() {
+  if (localBuffer) return *localBuffer;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  buffers.push_back(std::make_unique<ProfileBuffer>(static_cast<unsigned int>(buffers.size())));
+  localBuffer = buffers.back().get();
+  return *localBuffer;
+}
+
+const char* Profiler::intern(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return names.insert(name).first->c_str();
+}
+
+void Profiler::setThreadName(const std::string& name) {
+  const unsigned int threadId = threadBuffer().getThreadId();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  threadNames.emplace_back(threadId, name);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) return error("Profiler", "writeChromeTrace", "Failed to open " + path);
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  file << "{\"traceEvents\":[";
+  bool first = true;
+
+  for (const std::pair<unsigned int, std::string>& thread : threadNames) {
+    file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first << ",\"args\":{\"name\":\"";
+    writeEscaped(file, thread.second.c_str());
+    file << "\"}}";
+    first = false;
+  }
+
+  std::size_t eventCount = 0;
+  std::vector<ProfileEvent> events;
+  for (const std::unique_ptr<ProfileBuffer>& buffer : buffers) {
+    events.clear();
+    eventCount += buffer->snapshot(events);
+
+    for (const ProfileEvent& event : events) {
+      file << (first ? "" : ",") << "\n{\"name\":\"";
+      writeEscaped(file, event.name ? event.name : "unnamed");
+      file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->getThreadId()
+           << ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0
+           << ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) / 1000.0 << "}";
+      first = false;
+    }
+  }
+
+  file << "\n]}\n";
+  if (!file) return error("Profiler", "writeChromeTrace", "Failed to write " + path);
+
+  return debugLog("Profiler", "writeChromeTrace", "Wrote " + std::to_string(eventCount) + " zones to " + path);
+}
+
+void Profiler::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const std::unique_ptr<ProfileBuffer>& buffer : buffers)
+    buffer->clear();
+}
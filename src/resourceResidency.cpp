@@ -0,0 +1,118 @@
+#include "StarletEngine/resourceResidency.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+std::string ResourceResidency::entryKey(const ResourceUsage& usage) {
+  return std::to_string(index(usage.type)) + ":" + usage.key;
+}
+
+void ResourceResidency::setBudget(const std::size_t cpuBytes, const std::size_t gpuBytes) {
+  cpuBudget = cpuBytes;
+  gpuBudget = gpuBytes;
+  enforceBudget();
+}
+
+std::vector<ResourceUsage> ResourceResidency::collect(Scene& scene) const {
+  std::vector<ResourceUsage> usages;
+  if (hooks.collect) hooks.collect(scene, usages);
+  return usages;
+}
+
+void ResourceResidency::acquire(const std::vector<ResourceUsage>& usages) {
+  for (const ResourceUsage& usage : usages) {
+    const std::string key = entryKey(usage);
+
+    auto found = entries.find(key);
+    if (found == entries.end()) {
+      Entry entry;
+      entry.usage = usage;
+      entry.lruPosition = unreferenced.end();
+      found = entries.emplace(key, std::move(entry)).first;
+
+      ClassTotals& totals = resident[index(usage.type)];
+      totals.cpuBytes += usage.cpuBytes;
+      totals.gpuBytes += usage.gpuBytes;
+      ++totals.count;
+    }
+
+    Entry& entry = found->second;
+    if (entry.usage.cpuBytes != usage.cpuBytes || entry.usage.gpuBytes != usage.gpuBytes) {
+      ClassTotals& totals = resident[index(usage.type)];
+      totals.cpuBytes += usage.cpuBytes - entry.usage.cpuBytes;
+      totals.gpuBytes += usage.gpuBytes - entry.usage.gpuBytes;
+      entry.usage.cpuBytes = usage.cpuBytes;
+      entry.usage.gpuBytes = usage.gpuBytes;
+    }
+
+    if (entry.references++ == 0 && entry.lruPosition != unreferenced.end()) {
+      unreferenced.erase(entry.lruPosition);
+      entry.lruPosition = unreferenced.end();
+    }
+  }
+}
+
+void ResourceResidency::release(const std::vector<ResourceUsage>& usages) {
+  for (const ResourceUsage& usage : usages) {
+    const std::string key = entryKey(usage);
+
+    auto found = entries.find(key);
+    if (found == entries.end() || found->second.references == 0) {
+      debugLog("ResourceResidency", "release", "Released unknown resource " + usage.key);
+      continue;
+    }
+
+    Entry& entry = found->second;
+    if (--entry.references == 0)
+      entry.lruPosition = unreferenced.insert(unreferenced.end(), key);
+  }
+
+  enforceBudget();
+}
+
+bool ResourceResidency::overBudget() const {
+  if (cpuBudget == 0 && gpuBudget == 0) return !unreferenced.empty();
+  return (cpuBudget > 0 && getTotalCpuBytes() > cpuBudget)
+      || (gpuBudget > 0 && getTotalGpuBytes() > gpuBudget);
+}
+
+std::size_t ResourceResidency::enforceBudget() {
+  std::size_t evicted = 0;
+
+  for (auto it = unreferenced.begin(); it != unreferenced.end() && overBudget();) {
+    auto found = entries.find(*it);
+    const ResourceUsage& usage = found->second.usage;
+
+    if (hooks.evict && !hooks.evict(usage)) {
+      debugLog("ResourceResidency", "enforceBudget", "Failed to evict " + usage.key + ", keeping it resident");
+      ++it;
+      continue;
+    }
+
+    ClassTotals& totals = resident[index(usage.type)];
+    totals.cpuBytes -= usage.cpuBytes;
+    totals.gpuBytes -= usage.gpuBytes;
+    --totals.count;
+
+    entries.erase(found);
+    it = unreferenced.erase(it);
+    ++evicted;
+  }
+
+  evictions += evicted;
+  if ((cpuBudget > 0 || gpuBudget > 0) && overBudget())
+    debugLog("ResourceResidency", "enforceBudget", "Referenced resources exceed the memory budget: "
+      + std::to_string(getTotalCpuBytes()) + " CPU / " + std::to_string(getTotalGpuBytes()) + " GPU bytes resident");
+
+  return evicted;
+}
+
+std::size_t ResourceResidency::getTotalCpuBytes() const {
+  std::size_t total = 0;
+  for (const ClassTotals& totals : resident) total += totals.cpuBytes;
+  return total;
+}
+
+std::size_t ResourceResidency::getTotalGpuBytes() const {
+  std::size_t total = 0;
+  for (const ClassTotals& totals : resident) total += totals.gpuBytes;
+  return total;
+}
@@ -0,0 +1,197 @@
+#include "StarletEngine/sceneCooker.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include "StarletScene/components/camera.hpp"
+#include "StarletScene/components/grid.hpp"
+#include "StarletScene/components/light.hpp"
+#include "StarletScene/components/model.hpp"
+#include "StarletScene/components/primitive.hpp"
+#include "StarletScene/components/textureData.hpp"
+#include "StarletScene/components/transform.hpp"
+#include "StarletScene/components/velocity.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+  constexpr std::uint64_t FormatVersion{ 2 };
+  constexpr std::uint64_t FnvOffset{ 14695981039346656037ull };
+  constexpr std::uint64_t FnvPrime{ 1099511628211ull };
+
+  std::uint64_t hashBytes(const unsigned char* data, const std::size_t size, std::uint64_t hash) {
+    for (std::size_t i = 0; i < size; ++i) {
+      hash ^= data[i];
+      hash *= FnvPrime;
+    }
+    return hash;
+  }
+
+  std::uint64_t hashValue(const std::uint64_t value, const std::uint64_t hash) {
+    unsigned char bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    return hashBytes(bytes, sizeof(bytes), hash);
+  }
+
+  void writeU32(std::vector<unsigned char>& out, const std::uint32_t value) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(value));
+  }
+
+  struct Reader {
+    const unsigned char* data;
+    std::size_t size;
+    std::size_t offset{ 0 };
+
+    bool readU32(std::uint32_t& value) {
+      if (size - offset < sizeof(value)) return false;
+      std::memcpy(&value, data + offset, sizeof(value));
+      offset += sizeof(value);
+      return true;
+    }
+
+    const unsigned char* take(const std::size_t count) {
+      if (size - offset < count) return nullptr;
+      const unsigned char* taken = data + offset;
+      offset += count;
+      return taken;
+    }
+  };
+}
+
+bool SceneCooker::cook(Scene& scene, std::vector<unsigned char>& payload) const {
+  std::vector<std::vector<Entity>> owners(codecs.size());
+  std::vector<Entity> entities;
+  for (std::size_t i = 0; i < codecs.size(); ++i) {
+    owners[i] = codecs[i].entities(scene);
+    if (!owners[i].empty() && !codecs[i].write)
+      return error("SceneCooker", "cook", "Scene holds " + codecs[i].name + " components but no codec is registered for them");
+    entities.insert(entities.end(), owners[i].begin(), owners[i].end());
+  }
+
+  std::sort(entities.begin(), entities.end());
+  entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+
+  payload.clear();
+  writeU32(payload, static_cast<std::uint32_t>(entities.size()));
+  for (const Entity entity : entities) writeU32(payload, static_cast<std::uint32_t>(entity));
+
+  std::vector<unsigned char> component;
+  writeU32(payload, static_cast<std::uint32_t>(codecs.size()));
+  for (std::size_t i = 0; i < codecs.size(); ++i) {
+    const Codec& codec = codecs[i];
+    writeU32(payload, static_cast<std::uint32_t>(codec.name.size()));
+    payload.insert(payload.end(), codec.name.begin(), codec.name.end());
+    writeU32(payload, static_cast<std::uint32_t>(owners[i].size()));
+
+    for (const Entity entity : owners[i]) {
+      component.clear();
+      codec.write(codec.get(scene, entity), component);
+      writeU32(payload, static_cast<std::uint32_t>(entity));
+      writeU32(payload, static_cast<std::uint32_t>(component.size()));
+      payload.insert(payload.end(), component.begin(), component.end());
+    }
+  }
+
+  return true;
+}
+
+bool SceneCooker::restore(Scene& scene, const unsigned char* data, const std::size_t size) const {
+  Reader reader{ data, size };
+
+  std::uint32_t entityCount = 0;
+  if (!reader.readU32(entityCount)) return error("SceneCooker", "restore", "Truncated entity table");
+
+  std::unordered_map<std::uint32_t, Entity> remap;
+  remap.reserve(entityCount);
+  for (std::uint32_t i = 0; i < entityCount; ++i) {
+    std::uint32_t cooked = 0;
+    if (!reader.readU32(cooked)) return error("SceneCooker", "restore", "Truncated entity table");
+    remap[cooked] = scene.createEntity();
+  }
+
+  std::uint32_t codecCount = 0;
+  if (!reader.readU32(codecCount)) return error("SceneCooker", "restore", "Truncated component table");
+
+  for (std::uint32_t c = 0; c < codecCount; ++c) {
+    std::uint32_t nameSize = 0, count = 0;
+    const unsigned char* name = nullptr;
+    if (!reader.readU32(nameSize) || !(name = reader.take(nameSize)) || !reader.readU32(count))
+      return error("SceneCooker", "restore", "Truncated component table");
+
+    const std::string typeName(reinterpret_cast<const char*>(name), nameSize);
+    const auto codec = std::find_if(codecs.begin(), codecs.end(), [&typeName](const Codec& candidate) { return candidate.name == typeName; });
+    if (count > 0 && (codec == codecs.end() || !codec->read))
+      return error("SceneCooker", "restore", "No codec registered for cooked " + typeName + " components");
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+      std::uint32_t cooked = 0, componentSize = 0;
+      const unsigned char* component = nullptr;
+      if (!reader.readU32(cooked) || !reader.readU32(componentSize) || !(component = reader.take(componentSize)))
+        return error("SceneCooker", "restore", "Truncated " + typeName + " component");
+
+      const auto entity = remap.find(cooked);
+      if (entity == remap.end() || !codec->read(scene, entity->second, component, componentSize))
+        return error("SceneCooker", "restore", "Failed to restore " + typeName + " component");
+    }
+  }
+
+  return true;
+}
+
+bool SceneCooker::coversLayout(std::vector<Member> members, const std::size_t size, const std::size_t align) {
+  std::sort(members.begin(), members.end(), [](const Member& a, const Member& b) { return a.offset < b.offset; });
+
+  std::size_t end = 0;
+  for (const Member& member : members) {
+    if (member.offset < end || member.offset - end >= member.align) return false;
+    end = member.offset + member.size;
+  }
+  return end <= size && size - end < align;
+}
+
+void SceneCooker::writeField(std::vector<unsigned char>& out, const std::string& value) {
+  writeU32(out, static_cast<std::uint32_t>(value.size()));
+  out.insert(out.end(), value.begin(), value.end());
+}
+
+bool SceneCooker::readField(FieldReader& reader, std::string& value) {
+  std::uint32_t length = 0;
+  if (!readField(reader, length) || reader.size - reader.offset < length) return false;
+
+  value.assign(reinterpret_cast<const char*>(reader.data + reader.offset), length);
+  reader.offset += length;
+  return true;
+}
+
+std::uint64_t SceneCooker::getLayoutHash() const {
+  std::uint64_t hash = hashValue(FormatVersion, FnvOffset);
+  for (const Codec& codec : codecs) {
+    hash = hashBytes(reinterpret_cast<const unsigned char*>(codec.name.data()), codec.name.size(), hash);
+    hash = hashValue(codec.write ? 1 : 0, hash);
+    for (const std::size_t value : codec.layout) hash = hashValue(value, hash);
+  }
+  return hash;
+}
+
+SceneCookHooks SceneCooker::makeHooks(std::shared_ptr<const SceneCooker> cooker) {
+  SceneCookHooks hooks;
+  hooks.layout = cooker->getLayoutHash();
+  hooks.cook = [cooker](Scene& scene, std::vector<unsigned char>& payload) { return cooker->cook(scene, payload); };
+  hooks.restore = [cooker](Scene& scene, const unsigned char* data, const std::size_t size) { return cooker->restore(scene, data, size); };
+  return hooks;
+}
+
+std::shared_ptr<SceneCooker> SceneCooker::createDefault() {
+  std::shared_ptr<SceneCooker> cooker = std::make_shared<SceneCooker>();
+  cooker->addDefault<Transform>("Transform");
+  cooker->addDefault<Velocity>("Velocity");
+  cooker->addDefault<Camera>("Camera");
+  cooker->addDefault<Light>("Light");
+  cooker->addFields<Model>("Model", &Model::name, &Model::meshPath, &Model::isVisible, &Model::isLighted, &Model::useTextures,
+    &Model::textureNames, &Model::textureMixRatio, &Model::colour, &Model::specular);
+  cooker->addDefault<Primitive>("Primitive");
+  cooker->addDefault<Grid>("Grid");
+  cooker->addFields<TextureData>("TextureData", &TextureData::name, &TextureData::faces, &TextureData::isCube);
+  return cooker;
+}
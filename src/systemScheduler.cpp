@@ -0,0 +1,85 @@
+#include "StarletEngine/systemScheduler.hpp"
+#include "StarletEngine/threadPool.hpp"
+#include "StarletEngine/profiler.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <algorithm>
+
+namespace {
+  bool intersects(const ComponentSet& a, const ComponentSet& b) {
+    for (const std::type_index& type : a)
+      if (std::find(b.begin(), b.end(), type) != b.end()) return true;
+    return false;
+  }
+}
+
+void SystemScheduler::addSystem(const std::string& name, ComponentSet reads, ComponentSet writes, UpdateFn update) {
+  if (!update) {
+    error("SystemScheduler", "addSystem", "System " + name + " has no update function");
+    return;
+  }
+
+#ifdef STARLET_PROFILER
+  const char* profileName = Profiler::instance().intern(name);
+#else
+  const char* profileName = nullptr;
+#endif
+
+  systems.push_back({ name, profileName, std::move(reads), std::move(writes), std::move(update) });
+  dirty = true;
+}
+
+void SystemScheduler::clear() {
+  systems.clear();
+  batches.clear();
+  dirty = false;
+}
+
+std::size_t SystemScheduler::getBatchCount() {
+  if (dirty) build();
+  return batches.size();
+}
+
+bool SystemScheduler::conflicts(const SystemEntry& a, const SystemEntry& b) {
+  return intersects(a.writes, b.writes) || intersects(a.writes, b.reads) || intersects(a.reads, b.writes);
+}
+
+void SystemScheduler::build() {
+  std::vector<std::size_t> level(systems.size(), 0);
+  std::size_t levelCount = 0;
+
+  for (std::size_t j = 0; j < systems.size(); ++j) {
+    for (std::size_t i = 0; i < j; ++i)
+      if (conflicts(systems[i], systems[j])) level[j] = std::max(level[j], level[i] + 1);
+    levelCount = std::max(levelCount, level[j] + 1);
+  }
+
+  batches.assign(levelCount, {});
+  for (std::size_t i = 0; i < systems.size(); ++i)
+    batches[level[i]].push_back(i);
+
+  dirty = false;
+  debugLog("SystemScheduler", "build", std::to_string(systems.size()) + " systems in " + std::to_string(batches.size()) + " batches");
+}
+
+void SystemScheduler::update(Scene& scene, InputManager& input, const float deltaTime, ThreadPool& pool) {
+  if (dirty) build();
+
+  for (const std::vector<std::size_t>& batch : batches) {
+    TaskGroup group;
+    for (std::size_t i = 1; i < batch.size(); ++i) {
+      const SystemEntry& entry = systems[batch[i]];
+      pool.run(group, [&entry, &scene, &input, deltaTime]() {
+        STARLET_PROFILE_ZONE(entry.profileName);
+        entry.update(scene, input, deltaTime);
+      });
+    }
+
+    {
+      const SystemEntry& entry = systems[batch.front()];
+      STARLET_PROFILE_ZONE(entry.profileName);
+      entry.update(scene, input, deltaTime);
+    }
+    pool.wait(group);
+  }
+}
@@ -0,0 +1,137 @@
+#include "StarletEngine/threadPool.hpp"
+#include "StarletEngine/profiler.hpp"
+
+#include <algorithm>
+
+namespace {
+  thread_local const ThreadPool* currentPool{ nullptr };
+  thread_local int currentIndex{ -1 };
+}
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+  if (threadCount == 0) {
+    const unsigned int hardware = std::thread::hardware_concurrency();
+    threadCount = hardware > 1 ? hardware - 1 : 1;
+  }
+
+  queues.reserve(threadCount);
+  for (unsigned int i = 0; i < threadCount; ++i)
+    queues.push_back(std::make_unique<Queue>());
+
+  workers.reserve(threadCount);
+  for (unsigned int i = 0; i < threadCount; ++i)
+    workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopping = true;
+  }
+  sleepCondition.notify_all();
+
+  for (std::thread& worker : workers)
+    if (worker.joinable()) worker.join();
+}
+
+void ThreadPool::submit(Task task) {
+  const unsigned int index = (currentPool == this && currentIndex >= 0)
+    ? static_cast<unsigned int>(currentIndex)
+    : nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned int>(queues.size());
+
+  {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    queues[index]->tasks.push_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    pending.fetch_add(1, std::memory_order_release);
+  }
+  sleepCondition.notify_one();
+}
+
+void ThreadPool::run(TaskGroup& group, Task task) {
+  group.remaining.fetch_add(1, std::memory_order_relaxed);
+  submit([&group, task = std::move(task)]() {
+    task();
+    group.remaining.fetch_sub(1, std::memory_order_release);
+  });
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+  const int ownIndex = currentPool == this ? currentIndex : -1;
+  while (group.remaining.load(std::memory_order_acquire) > 0)
+    if (!tryRunOne(ownIndex)) std::this_thread::yield();
+}
+
+void ThreadPool::parallelFor(const std::size_t count, const std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body) {
+  if (count == 0) return;
+
+  const std::size_t chunk = std::max<std::size_t>(grain, 1);
+  if (count <= chunk) {
+    body(0, count);
+    return;
+  }
+
+  TaskGroup group;
+  for (std::size_t begin = chunk; begin < count; begin += chunk) {
+    const std::size_t end = std::min(begin + chunk, count);
+    run(group, [&body, begin, end]() { body(begin, end); });
+  }
+
+  body(0, chunk);
+  wait(group);
+}
+
+void ThreadPool::workerLoop(const unsigned int index) {
+  currentPool = this;
+  currentIndex = static_cast<int>(index);
+#ifdef STARLET_PROFILER
+  Profiler::instance().setThreadName("Worker " + std::to_string(index));
+#endif
+
+  while (true) {
+    if (tryRunOne(currentIndex)) continue;
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    sleepCondition.wait(lock, [this]() { return stopping.load() || pending.load(std::memory_order_acquire) > 0; });
+    if (stopping && pending.load(std::memory_order_acquire) == 0) return;
+  }
+}
+
+bool ThreadPool::tryRunOne(const int ownIndex) {
+  Task task;
+
+  const unsigned int thief = ownIndex >= 0 ? static_cast<unsigned int>(ownIndex) : nextQueue.load(std::memory_order_relaxed);
+  if (!(ownIndex >= 0 && popLocal(thief, task)) && !steal(thief, task))
+    return false;
+
+  pending.fetch_sub(1, std::memory_order_acq_rel);
+  task();
+  return true;
+}
+
+bool ThreadPool::popLocal(const unsigned int index, Task& out) {
+  Queue& queue = *queues[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) return false;
+
+  out = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::steal(const unsigned int thief, Task& out) {
+  const unsigned int count = static_cast<unsigned int>(queues.size());
+  for (unsigned int offset = 1; offset <= count; ++offset) {
+    Queue& queue = *queues[(thief + offset) % count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) continue;
+
+    out = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
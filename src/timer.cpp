@@ -1,24 +1,21 @@
 #include "StarletEngine/timer.hpp"
-#include "StarletSerializer/utils/log.hpp"
 
-#include "GLFW/glfw3.h"
+Timer::Timer() : startTime(Clock::now()), lastTime(startTime) {}
 
-Timer::Timer() : lastTime(0.0f) {}
+double Timer::tick() {
+	const Clock::time_point currentTime = Clock::now();
 
-float Timer::tick() {
-	const float currentTime = static_cast<float>(glfwGetTime());
-
-	if (lastTime == 0.0f) {
+	if (!started) {
+		started = true;
 		lastTime = currentTime;
-		return 0.0f;
+		return 0.0;
 	}
 
-	const float rawDelta = currentTime - lastTime;
-	constexpr float maxDelta = 0.1f;
-
+	const double deltaTime = std::chrono::duration<double>(currentTime - lastTime).count();
 	lastTime = currentTime;
-	float deltaTime = (rawDelta > maxDelta) ? maxDelta : rawDelta;
-
-	if (rawDelta > maxDelta) debugLog("Engine", "Tick", "deltaTime clamped to " + std::to_string(maxDelta) + " (was " + std::to_string(rawDelta) + ")");
 	return deltaTime;
-}
\ No newline at end of file
+}
+
+double Timer::elapsed() const {
+	return std::chrono::duration<double>(Clock::now() - startTime).count();
+}
@@ -0,0 +1,43 @@
+#include "StarletEngine/uploadQueue.hpp"
+
+bool UploadQueue::push(Task task) {
+  std::unique_lock<std::mutex> lock(mutex);
+  notFull.wait(lock, [this]() { return closed || tasks.size() < capacity; });
+  if (closed) return false;
+
+  tasks.push_back(std::move(task));
+  return true;
+}
+
+std::size_t UploadQueue::drain(const std::size_t maxTasks) {
+  std::size_t ran = 0;
+  while (ran < maxTasks) {
+    Task task;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (tasks.empty()) break;
+
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    notFull.notify_one();
+
+    task();
+    ++ran;
+  }
+  return ran;
+}
+
+void UploadQueue::close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    tasks.clear();
+  }
+  notFull.notify_all();
+}
+
+std::size_t UploadQueue::size() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return tasks.size();
+}
@@ -0,0 +1,111 @@
+#include "StarletEngine/viewport.hpp"
+#include "StarletEngine/window.hpp"
+#include "StarletSerializer/utils/log.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+float Viewport::getAspect() const {
+  return window.getHeight() > 0 ? window.getAspect() : 1.0f;
+}
+
+bool Viewport::shouldClose() const {
+  return window.shouldClose();
+}
+
+bool Viewport::begin() {
+  const unsigned int width = window.getWidth();
+  const unsigned int height = window.getHeight();
+  if (width == 0 || height == 0) return false;
+
+  if ((width != targetWidth || height != targetHeight) && !resizeTarget(width, height))
+    return false;
+
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glViewport(0, 0, width, height);
+  return true;
+}
+
+void Viewport::present(Window& mainWindow) {
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  GLsync rendered = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+
+  window.setCurrentWindow();
+  glWaitSync(rendered, 0, GL_TIMEOUT_IGNORED);
+  glDeleteSync(rendered);
+
+  if (presentFramebuffer == 0) {
+    glGenFramebuffers(1, &presentFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, presentFramebuffer);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+  }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, presentFramebuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+  glBlitFramebuffer(0, 0, targetWidth, targetHeight, 0, 0, window.getWidth(), window.getHeight(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  window.swapBuffers();
+
+  mainWindow.bindViewport();
+}
+
+void Viewport::destroy(Window& mainWindow) {
+  if (presentFramebuffer != 0) {
+    window.setCurrentWindow();
+    glDeleteFramebuffers(1, &presentFramebuffer);
+    presentFramebuffer = 0;
+  }
+
+  mainWindow.setCurrentWindow();
+  releaseTarget();
+}
+
+bool Viewport::resizeTarget(const unsigned int width, const unsigned int height) {
+  releaseTarget();
+
+  glGenTextures(1, &colorTexture);
+  glBindTexture(GL_TEXTURE_2D, colorTexture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glGenRenderbuffers(1, &depthBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+  const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  if (!complete) {
+    releaseTarget();
+    return error("Viewport", "resizeTarget", "Offscreen framebuffer is incomplete");
+  }
+
+  targetWidth = width;
+  targetHeight = height;
+  return true;
+}
+
+void Viewport::releaseTarget() {
+  if (framebuffer != 0) glDeleteFramebuffers(1, &framebuffer);
+  if (depthBuffer != 0) glDeleteRenderbuffers(1, &depthBuffer);
+  if (colorTexture != 0) glDeleteTextures(1, &colorTexture);
+
+  framebuffer = depthBuffer = colorTexture = 0;
+  targetWidth = targetHeight = 0;
+
+  if (presentFramebuffer != 0) {
+    GLFWwindow* current = glfwGetCurrentContext();
+    window.setCurrentWindow();
+    glDeleteFramebuffers(1, &presentFramebuffer);
+    presentFramebuffer = 0;
+    glfwMakeContextCurrent(current);
+  }
+}
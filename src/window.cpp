@@ -13,8 +13,8 @@ Window::~Window() {
 	}
 }
 
-bool Window::createWindow(const unsigned int widthIn, const unsigned int heightIn, const char* title) {
-	window = glfwCreateWindow(widthIn, heightIn, title, nullptr, nullptr);
+bool Window::createWindow(const unsigned int widthIn, const unsigned int heightIn, const char* title, GLFWwindow* share) {
+	window = glfwCreateWindow(widthIn, heightIn, title, nullptr, share);
 	if (!window) return error("Window", "createWindow", "Failed to create GLFW window");
 
 	width = widthIn;
@@ -47,6 +47,12 @@ void Window::updateViewport(const unsigned int widthIn, const unsigned int heigh
 	if (window) {
 		width = widthIn;
 		height = heightIn;
+		if (glfwGetCurrentContext() == window) glViewport(0, 0, width, height);
+	}
+}
+void Window::bindViewport() const {
+	if (window) {
+		glfwMakeContextCurrent(window);
 		glViewport(0, 0, width, height);
 	}
 }
@@ -2,26 +2,36 @@
 #include "StarletSerializer/utils/log.hpp"
 
 #include "StarletEngine/callbacks.hpp"
+#include "StarletEngine/profiler.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <cstdio>
 
-static constexpr int GL_MAJOR{ 3 };
-static constexpr int GL_MINOR{ 3 };
-
-WindowManager::WindowManager() {
-  if (!glfwInit()) error("WindowManager", "Constructor", "Failed to initialize GLFW\n");
-}
+WindowManager::WindowManager() {}
 WindowManager::~WindowManager() {
-  glfwTerminate();
+  sharedWindows.clear();
+  activeWindow.reset();
+  if (inputWindow) glfwDestroyWindow(inputWindow);
+  if (initialized) glfwTerminate();
+}
+
+bool WindowManager::init(const bool headless) {
+  if (initialized) return true;
+
+  glfwInitHint(GLFW_PLATFORM, headless ? GLFW_PLATFORM_NULL : GLFW_ANY_PLATFORM);
+  if (!glfwInit()) return error("WindowManager", "init", "Failed to initialize GLFW");
+
+  initialized = true;
+  return true;
 }
 
 bool WindowManager::createWindow(const unsigned int width, const unsigned int height, const char* title) {
-  debugLog("WindowManager", "createWindow", "Start time : " + std::to_string(glfwGetTime()));
+  STARLET_PROFILE_ZONE("createWindow");
+  if (!init()) return error("WindowManager", "createWindow", "GLFW is not initialized");
 
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, GL_MAJOR);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, GL_MINOR);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, glMajor);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, glMinor);
   glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
   activeWindow = std::make_unique<Window>();
@@ -36,17 +46,114 @@ bool WindowManager::createWindow(const unsigned int width, const unsigned int he
     return error("WindowManager", "createWindow", "Failed to initialize GLAD");
 
   GLFWwindow* window = activeWindow->getGLFWwindow();
-  glfwSetKeyCallback(window, key_callback);
-  glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-  glfwSetScrollCallback(window, scroll_callback);
-  glfwSetMouseButtonCallback(window, mouse_button_callback);
+  installCallbacks(window);
 
   glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-  glfwSwapInterval(1);
+  applySwapInterval();
 
   debugLog("Window", "OpenGL", "OpenGL Info");
   debugLog("Window", "OpenGL", "Version: " + std::string(reinterpret_cast<const char*>(glGetString(GL_VERSION))));
   debugLog("Window", "OpenGL", "Vendor: " + std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))));
-  debugLog("Window", "OpenGL", "Renderer: " + std::string(reinterpret_cast<const char*>(glGetString(GL_RENDERER))));
-  return debugLog("WindowManager", "createWindow", "Finish time: " + std::to_string(glfwGetTime()));
+  return debugLog("Window", "OpenGL", "Renderer: " + std::string(reinterpret_cast<const char*>(glGetString(GL_RENDERER))));
+}
+
+GLFWwindow* WindowManager::getInputWindow() {
+  if (activeWindow) return activeWindow->getGLFWwindow();
+  if (inputWindow || !initialized) return inputWindow;
+
+  glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  inputWindow = glfwCreateWindow(1, 1, "StarletInput", nullptr, nullptr);
+  glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
+
+  if (!inputWindow) error("WindowManager", "getInputWindow", "Failed to create context-less input window");
+  return inputWindow;
+}
+
+Window* WindowManager::createSharedWindow(const unsigned int width, const unsigned int height, const char* title) {
+  if (!activeWindow) {
+    error("WindowManager", "createSharedWindow", "Main window must exist before creating shared windows");
+    return nullptr;
+  }
+
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, glMajor);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, glMinor);
+  glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+  std::unique_ptr<Window> window = std::make_unique<Window>();
+  if (!window->createWindow(width, height, title, activeWindow->getGLFWwindow())) {
+    error("WindowManager", "createSharedWindow", "Shared window creation failed");
+    return nullptr;
+  }
+
+  window->setCurrentWindow();
+  glfwSwapInterval(0);
+  activeWindow->setCurrentWindow();
+
+  installCallbacks(window->getGLFWwindow());
+  if (userPointer) window->setWindowPointer(userPointer);
+
+  sharedWindows.push_back(std::move(window));
+  return sharedWindows.back().get();
+}
+
+void WindowManager::setPacingMode(const PacingMode mode) {
+  pacingMode = mode;
+  if (!activeWindow) return;
+
+  activeWindow->setCurrentWindow();
+  applySwapInterval();
+}
+
+void WindowManager::applySwapInterval() {
+  switch (pacingMode) {
+  case PacingMode::Vsync:
+    swapInterval = 1;
+    break;
+  case PacingMode::AdaptiveVsync:
+    if (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear")) swapInterval = -1;
+    else {
+      swapInterval = 1;
+      debugLog("WindowManager", "setPacingMode", "Adaptive vsync is not supported by the driver, using vsync");
+    }
+    break;
+  default:
+    swapInterval = 0;
+    break;
+  }
+
+  glfwSwapInterval(swapInterval);
+}
+
+void WindowManager::destroyWindow(Window* window) {
+  for (auto it = sharedWindows.begin(); it != sharedWindows.end(); ++it) {
+    if (it->get() != window) continue;
+
+    sharedWindows.erase(it);
+    if (activeWindow) activeWindow->setCurrentWindow();
+    return;
+  }
+}
+
+Window* WindowManager::findWindow(GLFWwindow* window) const {
+  if (activeWindow && activeWindow->getGLFWwindow() == window) return activeWindow.get();
+
+  for (const std::unique_ptr<Window>& shared : sharedWindows)
+    if (shared->getGLFWwindow() == window) return shared.get();
+  return nullptr;
+}
+
+void WindowManager::setWindowPointer(void* userPointerIn) {
+  userPointer = userPointerIn;
+
+  if (activeWindow) activeWindow->setWindowPointer(userPointer);
+  for (const std::unique_ptr<Window>& shared : sharedWindows)
+    shared->setWindowPointer(userPointer);
+}
+
+void WindowManager::installCallbacks(GLFWwindow* window) const {
+  glfwSetKeyCallback(window, key_callback);
+  glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+  glfwSetScrollCallback(window, scroll_callback);
+  glfwSetMouseButtonCallback(window, mouse_button_callback);
 }
@@ -0,0 +1,151 @@
+#include "StarletEngine/engine.hpp"
+
+#include "StarletScene/components/model.hpp"
+#include "StarletScene/components/textureData.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+  struct FakeGpu {
+    unsigned int nextHandle{ 1 };
+    std::vector<unsigned int> live;
+    std::size_t uploads{ 0 };
+  };
+
+  int failures = 0;
+
+  void check(const bool condition, const char* message) {
+    if (condition) return;
+    std::fprintf(stderr, "FAILED: %s\n", message);
+    ++failures;
+  }
+
+  void writeObj(const std::filesystem::path& path, const unsigned int triangles) {
+    std::ofstream file(path);
+    for (unsigned int i = 0; i < triangles; ++i) {
+      file << "v " << i << " 0 0\nv " << i << " 1 0\nv " << i << " 0 1\n";
+      file << "f " << i * 3 + 1 << " " << i * 3 + 2 << " " << i * 3 + 3 << "\n";
+    }
+  }
+
+  void writeTga(const std::filesystem::path& path, const unsigned char size) {
+    const unsigned char header[18]{ 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, size, 0, size, 0, 32, 8 };
+    const std::vector<char> texels(static_cast<std::size_t>(size) * size * 4, 0x7f);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(texels.data(), static_cast<std::streamsize>(texels.size()));
+  }
+
+  AssetBackend fakeBackend(FakeGpu& gpu) {
+    AssetBackend backend;
+    backend.upload = [&gpu](const AssetRequest&, const unsigned char*, const std::size_t size, GpuAsset& asset) {
+      asset.handles[0] = gpu.nextHandle++;
+      asset.gpuBytes = size;
+      gpu.live.push_back(asset.handles[0]);
+      ++gpu.uploads;
+      return true;
+    };
+    backend.release = [&gpu](const ResourceClass, const std::string&, const GpuAsset& asset) {
+      for (auto it = gpu.live.begin(); it != gpu.live.end(); ++it)
+        if (*it == asset.handles[0]) {
+          gpu.live.erase(it);
+          return;
+        }
+    };
+    return backend;
+  }
+
+  void addModel(Scene& scene, const char* meshPath) {
+    scene.addComponent<Model>(scene.createEntity()).meshPath = meshPath;
+  }
+
+  void addTexture(Scene& scene, const char* name, const char* file) {
+    TextureData& texture = scene.addComponent<TextureData>(scene.createEntity());
+    texture.name = name;
+    texture.faces[0] = file;
+  }
+
+  void generateA(Scene& scene) {
+    addModel(scene, "shared.obj");
+    addModel(scene, "shared.obj");
+    addModel(scene, "a.obj");
+    addTexture(scene, "a", "a.tga");
+  }
+
+  void generateB(Scene& scene) {
+    addModel(scene, "shared.obj");
+    addModel(scene, "b.obj");
+  }
+
+  bool isResident(const Engine& engine, const ResourceClass type, const char* name) {
+    return engine.getAssetStore().find(type, name) != nullptr;
+  }
+
+  std::size_t storedBytes(const Engine& engine, const ResourceClass type, std::initializer_list<const char*> names) {
+    std::size_t bytes = 0;
+    for (const char* name : names)
+      if (const GpuAsset* asset = engine.getAssetStore().find(type, name)) bytes += asset->gpuBytes;
+    return bytes;
+  }
+}
+
+int main() {
+  const std::filesystem::path root = std::filesystem::temp_directory_path() / "starletResidencyTest";
+  std::error_code errorCode;
+  std::filesystem::remove_all(root, errorCode);
+  std::filesystem::create_directories(root);
+  writeObj(root / "shared.obj", 4);
+  writeObj(root / "a.obj", 2);
+  writeObj(root / "b.obj", 8);
+  writeTga(root / "a.tga", 16);
+
+  FakeGpu gpu;
+  {
+    Engine engine;
+    engine.setAssetPaths(root.string());
+    engine.setAssetStoreEnabled(true);
+    engine.setAssetBackend(fakeBackend(gpu));
+    const ResourceResidency& residency = engine.getResourceResidency();
+
+    check(engine.loadGeneratedScene("A", generateA), "scene A loads");
+    check(gpu.live.size() == 3, "scene A uploads three resources");
+    check(residency.getResidentGpuBytes(ResourceClass::Mesh) == storedBytes(engine, ResourceClass::Mesh, { "shared.obj", "a.obj" }), "mesh counters match uploaded bytes");
+    check(residency.getResidentGpuBytes(ResourceClass::Texture) == storedBytes(engine, ResourceClass::Texture, { "a" }), "texture counters match uploaded bytes");
+
+    check(engine.loadGeneratedScene("B", generateB), "scene B loads");
+    check(!isResident(engine, ResourceClass::Mesh, "a.obj") && !isResident(engine, ResourceClass::Texture, "a"), "A -> B frees A-only resources");
+    check(isResident(engine, ResourceClass::Mesh, "shared.obj"), "A -> B keeps the shared mesh");
+    check(gpu.uploads == 4, "A -> B uploads only the B-only mesh");
+
+    check(engine.loadGeneratedScene("A", generateA), "scene A reloads");
+    check(!isResident(engine, ResourceClass::Mesh, "b.obj"), "A -> B -> A frees B-only resources");
+    check(isResident(engine, ResourceClass::Mesh, "shared.obj"), "A -> B -> A keeps the shared mesh");
+    check(gpu.live.size() == 3, "A -> B -> A leaves exactly scene A on the GPU");
+    check(residency.getResidentCount(ResourceClass::Mesh) == 2 && residency.getResidentCount(ResourceClass::Texture) == 1, "counters track scene A after the round trip");
+
+    engine.setResourceBudget(0, 1 << 20);
+    const std::size_t uploadsBeforeB = gpu.uploads;
+    check(engine.loadGeneratedScene("B", generateB), "scene B loads under a budget");
+    check(isResident(engine, ResourceClass::Mesh, "a.obj"), "a budget keeps unreferenced resources cached");
+    check(engine.loadGeneratedScene("A", generateA) && gpu.uploads == uploadsBeforeB + 1, "cached resources are not uploaded again");
+    check(engine.loadGeneratedScene("B", generateB), "scene B loads again");
+    engine.setResourceBudget(0, 1);
+    check(!isResident(engine, ResourceClass::Mesh, "a.obj") && !isResident(engine, ResourceClass::Texture, "a"), "shrinking the budget evicts cached resources");
+    check(isResident(engine, ResourceClass::Mesh, "b.obj"), "referenced resources survive eviction");
+
+    engine.setResourceBudget(0, 0);
+    check(engine.unloadScene(), "scene B unloads");
+    check(gpu.live.empty(), "unloading every scene frees every handle");
+  }
+
+  std::filesystem::remove_all(root, errorCode);
+  if (failures > 0) return EXIT_FAILURE;
+  std::printf("resourceResidencyTest passed\n");
+  return EXIT_SUCCESS;
+}